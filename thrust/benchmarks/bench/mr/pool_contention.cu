@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright (c) 2011-2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+// Compares the synchronized pool resources under contention: every thread repeatedly
+// allocates a batch of small blocks of mixed sizes and frees them again, which is the
+// pattern of many concurrent requests sharing one allocator. tls_pool is the baseline
+// without any sharing; it cannot free blocks allocated by another thread.
+
+#include <thrust/mr/new.h>
+#include <thrust/mr/sync_pool.h>
+#include <thrust/mr/thread_cached_pool.h>
+#include <thrust/mr/tls_pool.h>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nvbench_helper.cuh"
+
+template <class Resource>
+static void churn(Resource &resource, std::size_t operations)
+{
+  const std::size_t batch = 32;
+
+  std::vector<void *> blocks(batch);
+
+  for (std::size_t i = 0; i < operations; i += batch)
+  {
+    for (std::size_t j = 0; j < batch; ++j)
+    {
+      blocks[j] = resource.do_allocate(16 << (j % 6));
+    }
+
+    for (std::size_t j = 0; j < batch; ++j)
+    {
+      resource.do_deallocate(blocks[j], 16 << (j % 6));
+    }
+  }
+}
+
+template <class Worker>
+static void run_threads(std::size_t threads, Worker worker)
+{
+  std::vector<std::thread> pool;
+
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    pool.emplace_back(worker);
+  }
+
+  for (auto &thread : pool)
+  {
+    thread.join();
+  }
+}
+
+static void contention(nvbench::state &state)
+{
+  const auto threads    = static_cast<std::size_t>(state.get_int64("Threads"));
+  const auto operations = static_cast<std::size_t>(state.get_int64("Operations"));
+  const auto resource   = state.get_string("Resource");
+
+  thrust::mr::new_delete_resource upstream;
+
+  thrust::mr::synchronized_pool_resource<thrust::mr::new_delete_resource> synchronized(&upstream);
+  thrust::mr::thread_cached_pool_resource<thrust::mr::new_delete_resource> thread_cached(&upstream);
+
+  state.add_element_count(threads * operations);
+
+  // the threads are created in every variant, so their cost does not favour any resource
+  state.exec(nvbench::exec_tag::sync, [&](nvbench::launch &) {
+    if (resource == "synchronized_pool")
+    {
+      run_threads(threads, [&] { churn(synchronized, operations); });
+    }
+    else if (resource == "thread_cached_pool")
+    {
+      run_threads(threads, [&] { churn(thread_cached, operations); });
+    }
+    else
+    {
+      run_threads(threads, [&] {
+        churn(thrust::mr::tls_pool<thrust::mr::new_delete_resource, void>(&upstream), operations);
+      });
+    }
+  });
+}
+
+NVBENCH_BENCH(contention)
+  .set_name("contention")
+  .add_int64_power_of_two_axis("Threads", nvbench::range(0, 6, 1))
+  .add_int64_power_of_two_axis("Operations", nvbench::range(12, 16, 4))
+  .add_string_axis("Resource", {"synchronized_pool", "thread_cached_pool", "tls_pool"});
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright (c) 2011-2023, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ ******************************************************************************/
+
+// Compares each algorithm executed sequentially with the same algorithm executed in
+// parallel by a host backend. The sizes at which the parallel execution overtakes the
+// sequential one suggest a value for THRUST_OMP_SEQUENTIAL_CUTOFF or THRUST_TBB_SEQUENTIAL_CUTOFF.
+
+#include <thrust/copy.h>
+#include <thrust/device_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/for_each.h>
+#include <thrust/reduce.h>
+
+#include <cstddef>
+#include <limits>
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+#include <thrust/system/omp/execution_policy.h>
+namespace host_system = thrust::system::omp;
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+#include <thrust/system/tbb/execution_policy.h>
+namespace host_system = thrust::system::tbb;
+#endif
+
+#include "nvbench_helper.cuh"
+
+template <class T>
+struct square_t
+{
+  __host__ __device__ void operator()(T &val) const { val = val * val; }
+};
+
+template <class T>
+struct is_odd_t
+{
+  __host__ __device__ bool operator()(const T &val) const { return val % 2 != 0; }
+};
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+static auto host_policy(nvbench::state &state)
+{
+  const bool sequential = state.get_string("Execution") == "sequential";
+
+  return host_system::par.sequential_cutoff(sequential ? std::numeric_limits<std::ptrdiff_t>::max() : 0);
+}
+#endif
+
+template <typename T>
+static void for_each(nvbench::state &state, nvbench::type_list<T>)
+{
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+  const auto elements = static_cast<std::size_t>(state.get_int64("Elements"));
+
+  thrust::device_vector<T> data = generate(elements);
+
+  state.add_element_count(elements);
+  state.add_global_memory_reads<T>(elements);
+  state.add_global_memory_writes<T>(elements);
+
+  const auto policy = host_policy(state);
+
+  state.exec(nvbench::exec_tag::sync, [&](nvbench::launch &) {
+    thrust::for_each(policy, data.begin(), data.end(), square_t<T>{});
+  });
+#else
+  state.skip("The sequential cutoff only applies to the host backends.");
+#endif
+}
+
+template <typename T>
+static void reduce(nvbench::state &state, nvbench::type_list<T>)
+{
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+  const auto elements = static_cast<std::size_t>(state.get_int64("Elements"));
+
+  thrust::device_vector<T> in = generate(elements);
+
+  state.add_element_count(elements);
+  state.add_global_memory_reads<T>(elements);
+  state.add_global_memory_writes<T>(1);
+
+  const auto policy = host_policy(state);
+
+  state.exec(nvbench::exec_tag::sync, [&](nvbench::launch &) {
+    do_not_optimize(thrust::reduce(policy, in.begin(), in.end()));
+  });
+#else
+  state.skip("The sequential cutoff only applies to the host backends.");
+#endif
+}
+
+template <typename T>
+static void copy_if(nvbench::state &state, nvbench::type_list<T>)
+{
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+  const auto elements = static_cast<std::size_t>(state.get_int64("Elements"));
+
+  thrust::device_vector<T> input = generate(elements);
+  thrust::device_vector<T> output(elements);
+
+  state.add_element_count(elements);
+  state.add_global_memory_reads<T>(elements);
+  state.add_global_memory_writes<T>(elements / 2);
+
+  const auto policy = host_policy(state);
+
+  state.exec(nvbench::exec_tag::sync, [&](nvbench::launch &) {
+    thrust::copy_if(policy, input.cbegin(), input.cend(), output.begin(), is_odd_t<T>{});
+  });
+#else
+  state.skip("The sequential cutoff only applies to the host backends.");
+#endif
+}
+
+using types = nvbench::type_list<int32_t, int64_t>;
+
+NVBENCH_BENCH_TYPES(for_each, NVBENCH_TYPE_AXES(types))
+  .set_name("for_each")
+  .set_type_axes_names({"T{ct}"})
+  .add_int64_power_of_two_axis("Elements", nvbench::range(6, 20, 2))
+  .add_string_axis("Execution", {"sequential", "parallel"});
+
+NVBENCH_BENCH_TYPES(reduce, NVBENCH_TYPE_AXES(types))
+  .set_name("reduce")
+  .set_type_axes_names({"T{ct}"})
+  .add_int64_power_of_two_axis("Elements", nvbench::range(6, 20, 2))
+  .add_string_axis("Execution", {"sequential", "parallel"});
+
+NVBENCH_BENCH_TYPES(copy_if, NVBENCH_TYPE_AXES(types))
+  .set_name("copy_if")
+  .set_type_axes_names({"T{ct}"})
+  .add_int64_power_of_two_axis("Elements", nvbench::range(6, 20, 2))
+  .add_string_axis("Execution", {"sequential", "parallel"});
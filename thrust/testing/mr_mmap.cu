@@ -0,0 +1,101 @@
+#include <unittest/unittest.h>
+
+#include <thrust/detail/config.h>
+
+#if defined(__linux__)
+
+#include <thrust/mr/mmap.h>
+#include <thrust/mr/pool.h>
+#include <thrust/host_vector.h>
+#include <thrust/fill.h>
+#include <thrust/sequence.h>
+
+void TestMmapResource(thrust::mr::mmap_options options)
+{
+    thrust::mr::mmap_resource resource(options);
+
+    for (std::size_t size = 1; size <= (std::size_t(1) << 23); size = size * 3 + 1)
+    {
+        for (std::size_t alignment = 16; alignment <= (std::size_t(1) << 22); alignment <<= 3)
+        {
+            void * ptr = resource.do_allocate(size, alignment);
+            ASSERT_EQUAL(reinterpret_cast<std::size_t>(ptr) % alignment, 0u);
+
+            char * char_ptr = reinterpret_cast<char *>(ptr);
+            thrust::fill(char_ptr, char_ptr + size, char{1});
+
+            resource.do_deallocate(ptr, size, alignment);
+        }
+    }
+}
+
+void TestMmapResourceAlignedAllocation()
+{
+    thrust::mr::mmap_options options = thrust::mr::mmap_resource::get_default_options();
+
+    options.huge_pages = thrust::mr::mmap_no_huge_pages;
+    TestMmapResource(options);
+
+    options.huge_pages = thrust::mr::mmap_transparent_huge_pages;
+    TestMmapResource(options);
+
+    // falls back to transparent huge pages when no huge pages are reserved
+    options.huge_pages = thrust::mr::mmap_explicit_huge_pages;
+    TestMmapResource(options);
+
+    // pages of another size than the default one of the kernel, from their own pool
+    options.huge_page_size = std::size_t(1) << 30;
+    TestMmapResource(options);
+    options.huge_page_size = thrust::mr::mmap_resource::get_default_options().huge_page_size;
+
+    // on a single node, interleaving places every page on node 0
+    options.huge_pages = thrust::mr::mmap_transparent_huge_pages;
+    options.placement = thrust::mr::mmap_interleave;
+    options.node_mask = 1;
+    TestMmapResource(options);
+}
+DECLARE_UNITTEST(TestMmapResourceAlignedAllocation);
+
+void TestMmapOptionsValidate()
+{
+    thrust::mr::mmap_options options = thrust::mr::mmap_resource::get_default_options();
+    ASSERT_EQUAL(options.validate(), true);
+
+    options.huge_page_size = std::size_t(1) << 30;
+    ASSERT_EQUAL(options.validate(), true);
+
+    // huge page sizes are powers of two
+    options.huge_page_size = 3 * 1024 * 1024;
+    ASSERT_EQUAL(options.validate(), false);
+}
+DECLARE_UNITTEST(TestMmapOptionsValidate);
+
+void TestMmapResourcePoolUpstream()
+{
+    thrust::mr::mmap_resource upstream;
+    thrust::mr::unsynchronized_pool_resource<thrust::mr::mmap_resource> pool(&upstream);
+
+    thrust::host_vector<int, thrust::mr::allocator<int, thrust::mr::unsynchronized_pool_resource<thrust::mr::mmap_resource> > >
+        vec(1000, 13, &pool);
+
+    ASSERT_EQUAL(vec[999], 13);
+}
+DECLARE_UNITTEST(TestMmapResourcePoolUpstream);
+
+void TestMmapAllocatorHostVector()
+{
+    const std::size_t n = 3 * (1 << 20) + 5;
+
+    thrust::host_vector<int, thrust::mr::mmap_allocator<int> > vec(n);
+    thrust::sequence(vec.begin(), vec.end());
+
+    ASSERT_EQUAL(vec[n - 1], static_cast<int>(n - 1));
+
+    vec.resize(n / 2);
+    vec.shrink_to_fit();
+
+    ASSERT_EQUAL(vec[n / 2 - 1], static_cast<int>(n / 2 - 1));
+}
+DECLARE_UNITTEST(TestMmapAllocatorHostVector);
+
+#endif // __linux__
@@ -6,6 +6,14 @@
 
 #if _CCCL_STD_VER >= 2011
 #include <thrust/mr/sync_pool.h>
+#include <thrust/mr/thread_cached_pool.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #endif
 
 template<typename T>
@@ -249,6 +257,12 @@ void TestSynchronizedPool()
     TestPool<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedPool);
+
+void TestThreadCachedPool()
+{
+    TestPool<thrust::mr::thread_cached_pool_resource>();
+}
+DECLARE_UNITTEST(TestThreadCachedPool);
 #endif
 
 template<template<typename> class PoolTemplate>
@@ -332,6 +346,12 @@ void TestSynchronizedPoolCachingOversized()
     TestPoolCachingOversized<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedPoolCachingOversized);
+
+void TestThreadCachedPoolCachingOversized()
+{
+    TestPoolCachingOversized<thrust::mr::thread_cached_pool_resource>();
+}
+DECLARE_UNITTEST(TestThreadCachedPoolCachingOversized);
 #endif
 
 template<template<typename> class PoolTemplate>
@@ -356,5 +376,159 @@ void TestSynchronizedGlobalPool()
     TestGlobalPool<thrust::mr::synchronized_pool_resource>();
 }
 DECLARE_UNITTEST(TestSynchronizedGlobalPool);
+
+void TestThreadCachedGlobalPool()
+{
+    TestGlobalPool<thrust::mr::thread_cached_pool_resource>();
+}
+DECLARE_UNITTEST(TestThreadCachedGlobalPool);
+
+void TestThreadCachedPoolConcurrentThreads()
+{
+    typedef thrust::mr::thread_cached_pool_resource<thrust::mr::new_delete_resource> Pool;
+
+    thrust::mr::new_delete_resource upstream;
+    Pool pool(&upstream, Pool::get_default_options(), 8);
+
+    const int thread_count = 4;
+    const int block_count = 1000;
+
+    // each thread frees the blocks of its neighbour, so that blocks move between magazines
+    std::vector<std::vector<int *> > blocks(thread_count, std::vector<int *>(block_count));
+    std::vector<int> failures(thread_count, 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            for (int i = 0; i < block_count; ++i)
+            {
+                const std::size_t bytes = sizeof(int) * (1 + i % 64);
+                blocks[t][i] = static_cast<int *>(pool.do_allocate(bytes));
+                *blocks[t][i] = t * block_count + i;
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+
+    for (int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            const int other = (t + 1) % thread_count;
+            for (int i = 0; i < block_count; ++i)
+            {
+                if (*blocks[other][i] != other * block_count + i)
+                {
+                    ++failures[t];
+                }
+                pool.do_deallocate(blocks[other][i], sizeof(int) * (1 + i % 64));
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 0; t < thread_count; ++t)
+    {
+        ASSERT_EQUAL(failures[t], 0);
+    }
+
+    // the magazines of the exited threads went back to the central pool, whose blocks are reused
+    void * p = pool.do_allocate(sizeof(int));
+    pool.do_deallocate(p, sizeof(int));
+}
+DECLARE_UNITTEST(TestThreadCachedPoolConcurrentThreads);
+
+// counts the bytes it has handed out, and the calls made after it was marked destroyed
+class counting_resource final : public thrust::mr::memory_resource<>
+{
+public:
+    counting_resource() : outstanding(0), destroyed(false), calls_after_destroyed(0)
+    {
+    }
+
+    virtual void * do_allocate(std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        check_live();
+        outstanding += n;
+        return upstream.do_allocate(n, alignment);
+    }
+
+    virtual void do_deallocate(void * p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        check_live();
+        outstanding -= n;
+        upstream.do_deallocate(p, n, alignment);
+    }
+
+    std::atomic<std::size_t> outstanding;
+    std::atomic<bool> destroyed;
+    std::atomic<int> calls_after_destroyed;
+
+private:
+    void check_live()
+    {
+        if (destroyed.load())
+        {
+            ++calls_after_destroyed;
+        }
+    }
+
+    thrust::mr::new_delete_resource upstream;
+};
+
+void TestThreadCachedPoolThreadOutlivesResource()
+{
+    typedef thrust::mr::thread_cached_pool_resource<counting_resource> Pool;
+
+    counting_resource upstream;
+    std::unique_ptr<Pool> pool(new Pool(&upstream, Pool::get_default_options(), 8));
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool cached = false, destroyed = false;
+
+    // the thread leaves blocks in its magazine, and exits only after the resource is destroyed
+    std::thread thread([&]
+    {
+        void * p = pool->do_allocate(sizeof(int));
+        pool->do_deallocate(p, sizeof(int));
+
+        std::unique_lock<std::mutex> lock(mtx);
+        cached = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return destroyed; });
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&] { return cached; });
+    }
+
+    // the destructor returns the blocks cached by the thread, too
+    pool.reset();
+    ASSERT_EQUAL(upstream.outstanding.load(), 0u);
+
+    upstream.destroyed = true;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        destroyed = true;
+        cv.notify_all();
+    }
+
+    thread.join();
+
+    ASSERT_EQUAL(upstream.calls_after_destroyed.load(), 0);
+}
+DECLARE_UNITTEST(TestThreadCachedPoolThreadOutlivesResource);
 #endif
 
@@ -0,0 +1,189 @@
+#include <thrust/detail/config.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <unittest/unittest.h>
+
+#include <thrust/async/copy.h>
+#include <thrust/async/for_each.h>
+#include <thrust/async/reduce.h>
+#include <thrust/async/scan.h>
+#include <thrust/async/sort.h>
+#include <thrust/async/transform.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/omp/future.h>
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+template<typename T>
+struct times_three
+{
+  T operator()(T x) const
+  {
+    return 3 * x;
+  }
+};
+
+
+struct throw_on_visit
+{
+  template<typename T>
+  void operator()(T &) const
+  {
+    throw std::runtime_error("visited");
+  }
+};
+
+
+struct increment_on_thread
+{
+  std::mutex *mutex;
+  std::set<std::thread::id> *threads;
+
+  void operator()(int &x) const
+  {
+    std::lock_guard<std::mutex> lock(*mutex);
+    threads->insert(std::this_thread::get_id());
+    ++x;
+  }
+};
+
+
+void TestOmpAsyncReduce()
+{
+  thrust::host_vector<int> data(unittest::random_integers<int>(100000));
+
+  auto f = thrust::async::reduce(thrust::omp::par, data.begin(), data.end(), 0, thrust::plus<int>());
+
+  const int expected = thrust::reduce(data.begin(), data.end(), 0, thrust::plus<int>());
+
+  ASSERT_EQUAL(true, f.valid_content());
+  ASSERT_EQUAL(expected, f.get());
+  ASSERT_EQUAL(true, f.ready());
+  ASSERT_EQUAL(expected, f.extract());
+  ASSERT_EQUAL(false, f.valid_stream());
+}
+DECLARE_UNITTEST(TestOmpAsyncReduce);
+
+
+void TestOmpAsyncAfter()
+{
+  const size_t n = 100000;
+
+  thrust::host_vector<int> data(unittest::random_integers<int>(n));
+  thrust::host_vector<int> result(n);
+
+  thrust::host_vector<int> expected(n);
+  thrust::transform(data.begin(), data.end(), expected.begin(), times_three<int>());
+  thrust::sort(expected.begin(), expected.end());
+  thrust::inclusive_scan(expected.begin(), expected.end(), expected.begin());
+
+  auto e0 = thrust::async::transform(thrust::omp::par, data.begin(), data.end(), result.begin(), times_three<int>());
+  auto e1 = thrust::async::sort(thrust::omp::par.after(e0), result.begin(), result.end());
+  auto e2 = thrust::async::inclusive_scan(thrust::omp::par.after(e1), result.begin(), result.end(), result.begin());
+  auto f  = thrust::async::reduce(thrust::omp::par.after(e2), result.begin(), result.end(), 0, thrust::maximum<int>());
+
+  // the dependencies are moved into each algorithm
+  ASSERT_EQUAL(false, e0.valid_stream());
+  ASSERT_EQUAL(false, e1.valid_stream());
+  ASSERT_EQUAL(false, e2.valid_stream());
+
+  ASSERT_EQUAL(thrust::reduce(expected.begin(), expected.end(), 0, thrust::maximum<int>()), f.get());
+  ASSERT_EQUAL(expected, result);
+}
+DECLARE_UNITTEST(TestOmpAsyncAfter);
+
+
+void TestOmpAsyncWhenAll()
+{
+  const size_t n = 100000;
+
+  thrust::host_vector<int> data(n);
+  thrust::sequence(data.begin(), data.end());
+
+  thrust::host_vector<int> copy(n);
+  thrust::host_vector<int> scan(n);
+
+  auto e0 = thrust::async::copy(thrust::omp::par, data.begin(), data.end(), copy.begin());
+  auto e1 = thrust::async::exclusive_scan(thrust::omp::par, data.begin(), data.end(), scan.begin(), 1, thrust::plus<int>());
+
+  auto e = thrust::when_all(e0, e1);
+  e.wait();
+
+  ASSERT_EQUAL(true, e.ready());
+  ASSERT_EQUAL(data, copy);
+
+  thrust::host_vector<int> expected(n);
+  thrust::exclusive_scan(data.begin(), data.end(), expected.begin(), 1, thrust::plus<int>());
+  ASSERT_EQUAL(expected, scan);
+}
+DECLARE_UNITTEST(TestOmpAsyncWhenAll);
+
+
+void TestOmpAsyncException()
+{
+  thrust::host_vector<int> data(10);
+
+  auto e0 = thrust::async::for_each(thrust::omp::par, data.begin(), data.end(), throw_on_visit());
+  auto e1 = thrust::async::sort(thrust::omp::par.after(e0), data.begin(), data.end());
+
+  // the exception of a dependency is rethrown by each dependent
+  ASSERT_THROWS(e1.wait(), std::runtime_error);
+}
+DECLARE_UNITTEST(TestOmpAsyncException);
+
+void TestOmpAsyncManyTasks()
+{
+  const int n = 256;
+
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  increment_on_thread f = {&mutex, &threads};
+
+  // a single element is visited by the thread which runs the task
+  thrust::host_vector<int> counter(1, 0);
+
+  auto e = thrust::async::for_each(thrust::omp::par, counter.begin(), counter.end(), f);
+
+  for(int i = 1; i < n; ++i)
+  {
+    e = thrust::async::for_each(thrust::omp::par.after(e), counter.begin(), counter.end(), f);
+  }
+
+  // more independent tasks than threads in the pool
+  std::vector<thrust::host_vector<int> > counters(n, thrust::host_vector<int>(1, 0));
+  std::vector<thrust::omp::event> events;
+
+  for(int i = 0; i < n; ++i)
+  {
+    events.push_back(thrust::async::for_each(thrust::omp::par, counters[i].begin(), counters[i].end(), f));
+  }
+
+  e.wait();
+
+  for(int i = 0; i < n; ++i)
+  {
+    events[i].wait();
+    ASSERT_EQUAL(1, counters[i][0]);
+  }
+
+  ASSERT_EQUAL(n, counter[0]);
+
+  // the tasks share a bounded pool of threads rather than starting one each
+  ASSERT_EQUAL(true, threads.size() <= static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())));
+}
+DECLARE_UNITTEST(TestOmpAsyncManyTasks);
+
+#endif // C++14
+
@@ -0,0 +1,30 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/inner_product.h>
+#include <thrust/system/omp/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestOmpParInnerProduct(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+
+  ASSERT_EQUAL(thrust::inner_product(policy, data.begin(), data.end(), data.begin(), T(0)),
+               thrust::inner_product(data.begin(), data.end(), data.begin(), T(0)));
+}
+
+template<typename T>
+struct TestOmpParInnerProductPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestOmpParInnerProduct<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestOmpParInnerProductPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestOmpParInnerProductPoliciesInstance;
@@ -0,0 +1,86 @@
+#include <unittest/unittest.h>
+
+#include <thrust/merge.h>
+#include <thrust/sort.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+void TestOmpMergeLargeInputs(const thrust::host_vector<int> &a, const thrust::host_vector<int> &b)
+{
+  const size_t n1 = a.size(), n2 = b.size();
+
+  // the values tell which input, and which position in it, each key came from
+  std::vector<std::pair<int, size_t> > a_pairs(n1), b_pairs(n2), reference;
+  thrust::host_vector<size_t> a_values(n1), b_values(n2);
+  for(size_t i = 0; i < n1; ++i)
+  {
+    a_values[i] = i;
+    a_pairs[i]  = std::make_pair(a[i], i);
+  }
+  for(size_t i = 0; i < n2; ++i)
+  {
+    b_values[i] = n1 + i;
+    b_pairs[i]  = std::make_pair(b[i], n1 + i);
+  }
+
+  // equal keys are taken from a first
+  std::merge(a_pairs.begin(), a_pairs.end(), b_pairs.begin(), b_pairs.end(), std::back_inserter(reference),
+             [](const std::pair<int, size_t> &x, const std::pair<int, size_t> &y) { return x.first < y.first; });
+
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    thrust::host_vector<int> merged(n1 + n2);
+    thrust::merge(thrust::omp::par.num_threads(threads).sequential_cutoff(0), a.begin(), a.end(), b.begin(), b.end(), merged.begin());
+
+    thrust::host_vector<int>    keys(n1 + n2);
+    thrust::host_vector<size_t> values(n1 + n2);
+    thrust::merge_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0),
+                         a.begin(), a.end(), b.begin(), b.end(), a_values.begin(), b_values.begin(),
+                         keys.begin(), values.begin());
+
+    bool matches = true;
+    for(size_t i = 0; i < n1 + n2; ++i)
+    {
+      matches = matches && merged[i] == reference[i].first && keys[i] == reference[i].first && values[i] == reference[i].second;
+    }
+
+    ASSERT_EQUAL(true, matches);
+  }
+}
+
+void TestOmpMergeLarge()
+{
+  const size_t n1 = 70001, n2 = 50003;
+
+  // few distinct keys, so that runs of equal keys straddle the tiles
+  thrust::host_vector<int> a = unittest::random_integers<int>(n1);
+  thrust::host_vector<int> b = unittest::random_integers<int>(n2);
+  for(size_t i = 0; i < n1; ++i)
+  {
+    a[i] %= 1000;
+  }
+  for(size_t i = 0; i < n2; ++i)
+  {
+    b[i] %= 1000;
+  }
+
+  thrust::sort(a.begin(), a.end());
+  thrust::sort(b.begin(), b.end());
+  TestOmpMergeLargeInputs(a, b);
+
+  // every key of b precedes every key of a, so that each tile falls in one input
+  for(size_t i = 0; i < n1; ++i)
+  {
+    a[i] = static_cast<int>(n2 + i);
+  }
+  for(size_t i = 0; i < n2; ++i)
+  {
+    b[i] = static_cast<int>(i);
+  }
+  TestOmpMergeLargeInputs(a, b);
+}
+DECLARE_UNITTEST(TestOmpMergeLarge);
@@ -0,0 +1,360 @@
+#include <unittest/unittest.h>
+
+#include <thrust/for_each.h>
+#include <thrust/memory.h>
+#include <thrust/random.h>
+#include <thrust/reduce.h>
+#include <thrust/sort.h>
+#include <thrust/sequence.h>
+#include <thrust/shuffle.h>
+#include <thrust/uninitialized_fill.h>
+#include <thrust/system/detail/internal/temporary_pool.h>
+#include <thrust/system/omp/execution_policy.h>
+#include <thrust/system/omp/vector.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+
+struct record_num_threads
+{
+  template<typename T>
+  void operator()(T &x) const
+  {
+#if defined(_OPENMP)
+    x = omp_get_num_threads();
+#else
+    x = 1;
+#endif
+  }
+};
+
+
+void TestOmpParNumThreads()
+{
+  thrust::host_vector<int> v(1000, 0);
+
+  thrust::for_each(thrust::omp::par.num_threads(3).sequential_cutoff(0), v.begin(), v.end(), record_num_threads());
+
+  ASSERT_EQUAL(v, thrust::host_vector<int>(1000, 3));
+
+  thrust::for_each(thrust::omp::par.num_threads(1).sequential_cutoff(0), v.begin(), v.end(), record_num_threads());
+
+  ASSERT_EQUAL(v, thrust::host_vector<int>(1000, 1));
+}
+DECLARE_UNITTEST(TestOmpParNumThreads);
+
+
+void TestOmpParSequentialCutoff()
+{
+  thrust::host_vector<int> v(1000, 0);
+
+  // below the cutoff, no parallel region is opened
+  thrust::for_each(thrust::omp::par.num_threads(3).sequential_cutoff(1001), v.begin(), v.end(), record_num_threads());
+
+  ASSERT_EQUAL(v, thrust::host_vector<int>(1000, 1));
+
+  thrust::for_each(thrust::omp::par.sequential_cutoff(1000).num_threads(3), v.begin(), v.end(), record_num_threads());
+
+  ASSERT_EQUAL(v, thrust::host_vector<int>(1000, 3));
+
+#if THRUST_OMP_SEQUENTIAL_CUTOFF > 1
+  thrust::host_vector<int> w(THRUST_OMP_SEQUENTIAL_CUTOFF - 1, 0);
+
+  thrust::for_each(thrust::omp::par.num_threads(3), w.begin(), w.end(), record_num_threads());
+
+  ASSERT_EQUAL(w, thrust::host_vector<int>(THRUST_OMP_SEQUENTIAL_CUTOFF - 1, 1));
+#endif
+}
+DECLARE_UNITTEST(TestOmpParSequentialCutoff);
+
+
+void TestOmpParScheduleRestoresSchedule()
+{
+#if defined(_OPENMP)
+  omp_sched_t kind_before;
+  int chunk_before;
+  omp_get_schedule(&kind_before, &chunk_before);
+
+  thrust::host_vector<int> v(1000, 0);
+
+  thrust::for_each(thrust::omp::par.schedule(thrust::omp::schedule_guided, 5), v.begin(), v.end(), record_num_threads());
+
+  omp_sched_t kind_after;
+  int chunk_after;
+  omp_get_schedule(&kind_after, &chunk_after);
+
+  ASSERT_EQUAL(static_cast<int>(kind_before), static_cast<int>(kind_after));
+  ASSERT_EQUAL(chunk_before, chunk_after);
+#endif
+}
+DECLARE_UNITTEST(TestOmpParScheduleRestoresSchedule);
+
+
+void TestOmpParShuffleIsReproducible()
+{
+  // large enough to fall into several buckets
+  const size_t n = 3 * (1 << 16) + 17;
+
+  thrust::host_vector<unsigned int> sequence(n);
+  thrust::sequence(sequence.begin(), sequence.end());
+
+  thrust::host_vector<unsigned int> expected = sequence;
+  thrust::default_random_engine g(0xD5);
+  thrust::shuffle(thrust::omp::par.sequential_cutoff(n + 1), expected.begin(), expected.end(), g);
+
+  ASSERT_EQUAL(false, expected == sequence);
+
+  // the permutation does not depend on the number of threads
+  for(int threads = 1; threads < 6; threads += 2)
+  {
+    thrust::host_vector<unsigned int> shuffled = sequence;
+    g.seed(0xD5);
+    thrust::shuffle(thrust::omp::par.num_threads(threads).sequential_cutoff(0), shuffled.begin(), shuffled.end(), g);
+    ASSERT_EQUAL(expected, shuffled);
+
+    thrust::host_vector<unsigned int> copied(n);
+    g.seed(0xD5);
+    thrust::shuffle_copy(thrust::omp::par.num_threads(threads).sequential_cutoff(0), sequence.begin(), sequence.end(), copied.begin(), g);
+    ASSERT_EQUAL(expected, copied);
+  }
+
+  thrust::sort(expected.begin(), expected.end());
+  ASSERT_EQUAL(sequence, expected);
+}
+DECLARE_UNITTEST(TestOmpParShuffleIsReproducible);
+
+void TestOmpParTemporaryStorageIsPooled()
+{
+  thrust::omp::release_temporary_storage();
+
+  // a buffer reuses the storage just returned to its size class
+  const std::ptrdiff_t sizes[] = {100, 3 << 18, 5 << 17};
+
+  for(std::ptrdiff_t n : sizes)
+  {
+    auto first = thrust::get_temporary_buffer<int>(thrust::omp::par, n);
+    ASSERT_EQUAL(n, first.second);
+    thrust::return_temporary_buffer(thrust::omp::par, first.first, first.second);
+
+    auto second = thrust::get_temporary_buffer<int>(thrust::omp::par, n);
+#if !defined(THRUST_OMP_DISABLE_TEMPORARY_POOL)
+    ASSERT_EQUAL(true, first.first.get() == second.first.get());
+#endif
+    thrust::return_temporary_buffer(thrust::omp::par, second.first, second.second);
+  }
+
+  thrust::omp::release_temporary_storage();
+
+  // algorithms of different sizes share the pool
+  for(size_t n = (1 << 18) - 3; n < (1 << 19); n += (1 << 17) + 1)
+  {
+    thrust::host_vector<int> h_data = unittest::random_integers<int>(n);
+    thrust::host_vector<int> d_data = h_data;
+
+    thrust::stable_sort(h_data.begin(), h_data.end());
+    thrust::stable_sort(thrust::omp::par.sequential_cutoff(0), d_data.begin(), d_data.end());
+
+    ASSERT_EQUAL(h_data, d_data);
+  }
+
+  thrust::omp::release_temporary_storage();
+}
+DECLARE_UNITTEST(TestOmpParTemporaryStorageIsPooled);
+
+
+#if !defined(THRUST_OMP_DISABLE_TEMPORARY_POOL)
+void TestOmpReleaseTemporaryStorageOfEveryThread()
+{
+  typedef thrust::system::detail::internal::temporary_pool pool_type;
+
+  thrust::omp::release_temporary_storage();
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  pool_type *worker_pool = nullptr;
+  bool done = false;
+
+  // the worker caches a buffer in its pool and waits until the pool has been checked
+  std::thread worker([&]
+  {
+    auto buffer = thrust::get_temporary_buffer<int>(thrust::omp::par, 1 << 20);
+    thrust::return_temporary_buffer(thrust::omp::par, buffer.first, buffer.second);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    worker_pool = &thrust::system::detail::internal::tls_temporary_pool();
+    cv.notify_all();
+    cv.wait(lock, [&] { return done; });
+  });
+
+  std::size_t cached_before = 0, cached_after = 0;
+
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [&] { return worker_pool != nullptr; });
+
+    cached_before = worker_pool->cached_bytes();
+    thrust::omp::release_temporary_storage();
+    cached_after = worker_pool->cached_bytes();
+
+    done = true;
+    cv.notify_all();
+  }
+
+  worker.join();
+
+  ASSERT_EQUAL(cached_before, std::size_t(4) << 20);
+  ASSERT_EQUAL(cached_after, std::size_t(0));
+}
+DECLARE_UNITTEST(TestOmpReleaseTemporaryStorageOfEveryThread);
+
+void TestOmpTemporaryStorageCacheIsBounded()
+{
+  typedef thrust::system::detail::internal::temporary_pool pool_type;
+
+  thrust::omp::release_temporary_storage();
+
+  pool_type &pool = thrust::system::detail::internal::tls_temporary_pool();
+
+  // one block more than the cap holds
+  const std::size_t max_cached_bytes = pool_type::max_cached_bytes;
+  const std::size_t num_blocks = 3;
+  const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(max_cached_bytes / 2 / sizeof(int));
+
+  std::vector<decltype(thrust::get_temporary_buffer<int>(thrust::omp::par, n))> buffers;
+
+  for(std::size_t i = 0; i < num_blocks; ++i)
+  {
+    buffers.push_back(thrust::get_temporary_buffer<int>(thrust::omp::par, n));
+  }
+
+  for(std::size_t i = 0; i < num_blocks; ++i)
+  {
+    thrust::return_temporary_buffer(thrust::omp::par, buffers[i].first, buffers[i].second);
+  }
+
+  ASSERT_EQUAL(pool.cached_bytes(), max_cached_bytes);
+
+  thrust::omp::release_temporary_storage();
+}
+DECLARE_UNITTEST(TestOmpTemporaryStorageCacheIsBounded);
+#endif
+
+
+// records the thread which copy constructs it; a copy constructor which may throw
+// would not be run in parallel
+struct first_touch
+{
+  int thread;
+
+  first_touch() : thread(-1) {}
+
+  first_touch(const first_touch &) noexcept
+#if defined(_OPENMP)
+    : thread(omp_get_thread_num())
+#else
+    : thread(0)
+#endif
+  {}
+};
+
+void TestOmpParUninitializedFillFirstTouch()
+{
+  const size_t n = 100003;
+  const int threads = 4;
+
+  thrust::omp::vector<first_touch> data(n);
+  thrust::uninitialized_fill(thrust::omp::par.num_threads(threads), data.begin(), data.end(), first_touch());
+
+  // each tile of the decomposition is touched by the thread of the same index
+  const first_touch *result = thrust::raw_pointer_cast(data.data());
+  const size_t tile = (n + threads - 1) / threads;
+
+  bool in_order = true;
+
+  for(size_t i = 0; i < n; ++i)
+  {
+#if defined(_OPENMP)
+    in_order = in_order && result[i].thread == static_cast<int>(i / tile);
+#else
+    in_order = in_order && result[i].thread == 0;
+#endif
+  }
+
+  ASSERT_EQUAL(true, in_order);
+
+  thrust::omp::vector<int> zeros(n);
+  ASSERT_EQUAL(0, thrust::reduce(zeros.begin(), zeros.end()));
+
+  thrust::omp::vector<int> sevens(n, 7);
+  ASSERT_EQUAL(7 * static_cast<int>(n), thrust::reduce(sevens.begin(), sevens.end()));
+}
+DECLARE_UNITTEST(TestOmpParUninitializedFillFirstTouch);
+
+
+// throws from the copy constructor once copies_left copies have been made, or never
+// when copies_left is negative
+struct throwing_copy
+{
+  static int copies_left;
+
+  int value;
+
+  throwing_copy() : value(0) {}
+
+  throwing_copy(int value) : value(value) {}
+
+  throwing_copy(const throwing_copy &other)
+    : value(other.value)
+  {
+    if(copies_left-- == 0)
+    {
+      throw std::runtime_error("throwing_copy");
+    }
+  }
+};
+
+int throwing_copy::copies_left = 0;
+
+void TestOmpParUninitializedFillThrowingCopy()
+{
+  const size_t n = 100003;
+
+  // the exception of the copy constructor reaches the caller
+  std::vector<throwing_copy> data(n);
+
+  throwing_copy::copies_left = static_cast<int>(n / 2);
+
+  bool caught = false;
+
+  try
+  {
+    thrust::uninitialized_fill(thrust::omp::par.num_threads(4).sequential_cutoff(0), data.begin(), data.end(), throwing_copy(13));
+  }
+  catch(const std::runtime_error &)
+  {
+    caught = true;
+  }
+
+  ASSERT_EQUAL(true, caught);
+
+  throwing_copy::copies_left = -1;
+
+  thrust::uninitialized_fill(thrust::omp::par.num_threads(4).sequential_cutoff(0), data.begin(), data.end(), throwing_copy(7));
+
+  bool filled = true;
+  for(size_t i = 0; i < n; ++i)
+  {
+    filled = filled && data[i].value == 7;
+  }
+
+  ASSERT_EQUAL(true, filled);
+}
+DECLARE_UNITTEST(TestOmpParUninitializedFillThrowingCopy);
@@ -0,0 +1,30 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/reduce.h>
+#include <thrust/system/omp/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestOmpParReduce(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+
+  ASSERT_EQUAL(thrust::reduce(policy, data.begin(), data.end()),
+               thrust::reduce(data.begin(), data.end()));
+}
+
+template<typename T>
+struct TestOmpParReducePolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestOmpParReduce<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestOmpParReducePolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestOmpParReducePoliciesInstance;
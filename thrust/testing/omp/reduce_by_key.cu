@@ -0,0 +1,78 @@
+#include <unittest/unittest.h>
+
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <algorithm>
+
+// keys in runs of one element, of a few and of more than a tile
+thrust::host_vector<int> reduce_by_key_runs(size_t n)
+{
+  const size_t run_lengths[] = {1, 3, 1, 40000, 7, 1000, 1, 1};
+  const size_t num_run_lengths = sizeof(run_lengths) / sizeof(run_lengths[0]);
+
+  thrust::host_vector<int> keys(n);
+
+  size_t run = 0;
+  for(size_t i = 0; i < n; ++run)
+  {
+    const size_t end = std::min(n, i + run_lengths[run % num_run_lengths]);
+
+    for(; i < end; ++i)
+    {
+      keys[i] = static_cast<int>(run);
+    }
+  }
+
+  return keys;
+}
+
+// treats the keys of four consecutive runs as equal
+struct equal_quarter
+{
+  bool operator()(int x, int y) const
+  {
+    return x / 4 == y / 4;
+  }
+};
+
+template<typename BinaryPredicate, typename BinaryFunction>
+void TestOmpReduceByKeyLargeWith(BinaryPredicate pred, BinaryFunction op)
+{
+  const size_t n = (1 << 17) + 3;
+
+  thrust::host_vector<int> keys = reduce_by_key_runs(n);
+  thrust::host_vector<unittest::int64_t> values = unittest::random_integers<unittest::int64_t>(n);
+
+  thrust::host_vector<int> h_keys(n), d_keys(n);
+  thrust::host_vector<unittest::int64_t> h_values(n), d_values(n);
+
+  const size_t num_runs =
+    thrust::reduce_by_key(keys.begin(), keys.end(), values.begin(), h_keys.begin(), h_values.begin(), pred, op).first - h_keys.begin();
+  h_keys.resize(num_runs);
+  h_values.resize(num_runs);
+
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    d_keys.resize(n);
+    d_values.resize(n);
+
+    const size_t d_num_runs =
+      thrust::reduce_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0),
+                            keys.begin(), keys.end(), values.begin(), d_keys.begin(), d_values.begin(), pred, op).first - d_keys.begin();
+    d_keys.resize(d_num_runs);
+    d_values.resize(d_num_runs);
+
+    ASSERT_EQUAL(h_keys, d_keys);
+    ASSERT_EQUAL(h_values, d_values);
+  }
+}
+
+void TestOmpReduceByKeyLarge()
+{
+  TestOmpReduceByKeyLargeWith(thrust::equal_to<int>(), thrust::plus<unittest::int64_t>());
+  TestOmpReduceByKeyLargeWith(thrust::equal_to<int>(), thrust::maximum<unittest::int64_t>());
+  TestOmpReduceByKeyLargeWith(equal_quarter(), thrust::plus<unittest::int64_t>());
+}
+DECLARE_UNITTEST(TestOmpReduceByKeyLarge);
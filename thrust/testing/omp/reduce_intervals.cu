@@ -4,6 +4,9 @@
 #include <thrust/system/detail/internal/decompose.h>
 #include <thrust/system/omp/detail/reduce_intervals.h>
 
+#include <string>
+#include <vector>
+
 // CPP reference implementation 
 template<typename InputIterator,
          typename OutputIterator,
@@ -103,3 +106,41 @@ struct TestOmpReduceIntervals
 };
 VariableUnitTest<TestOmpReduceIntervals, IntegralTypes> TestOmpReduceIntervalsInstance;
 
+
+
+// an associative but not commutative operation
+struct concatenate
+{
+  std::string operator()(const std::string &a, const std::string &b) const
+  {
+    return a + b;
+  }
+};
+
+void TestOmpReduceIntervalsNonCommutative(void)
+{
+  using thrust::system::omp::detail::reduce_intervals;
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  // intervals both shorter and longer than the independent sums of a tile
+  for(int n = 1; n < 100; n += 7)
+  {
+    std::vector<std::string> input(n);
+    for(int i = 0; i < n; ++i)
+    {
+      input[i] = std::string(1, static_cast<char>('a' + i % 26));
+    }
+
+    uniform_decomposition<int> decomp(n, 1, 3);
+
+    std::vector<std::string> h_output(decomp.size());
+    std::vector<std::string> d_output(decomp.size());
+
+    ::reduce_intervals(input.begin(), h_output.begin(), concatenate(), decomp);
+    thrust::system::omp::tag omp_tag;
+    reduce_intervals(omp_tag, input.begin(), d_output.begin(), concatenate(), decomp);
+
+    ASSERT_EQUAL(h_output == d_output, true);
+  }
+}
+DECLARE_UNITTEST(TestOmpReduceIntervalsNonCommutative);
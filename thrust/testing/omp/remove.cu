@@ -0,0 +1,142 @@
+#include <unittest/unittest.h>
+
+#include <thrust/copy.h>
+#include <thrust/functional.h>
+#include <thrust/partition.h>
+#include <thrust/remove.h>
+#include <thrust/unique.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+template<typename T>
+void TestOmpCompactInPlaceThreads(const std::vector<T> &input)
+{
+  // runs of equal elements, some of which straddle the tiles
+  auto is_odd_length = [](const T &x) { return x.size() % 2 == 1; };
+
+  std::vector<T> removed_reference = input;
+  removed_reference.erase(std::remove_if(removed_reference.begin(), removed_reference.end(), is_odd_length),
+                          removed_reference.end());
+
+  std::vector<T> unique_reference = input;
+  unique_reference.erase(std::unique(unique_reference.begin(), unique_reference.end()),
+                         unique_reference.end());
+
+  // every tile but the first moves its elements down, unless a single tile is used
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    std::vector<T> removed = input;
+    removed.erase(thrust::remove_if(thrust::omp::par.num_threads(threads).sequential_cutoff(0), removed.begin(), removed.end(), is_odd_length),
+                  removed.end());
+
+    std::vector<T> unique = input;
+    unique.erase(thrust::unique(thrust::omp::par.num_threads(threads).sequential_cutoff(0), unique.begin(), unique.end()),
+                 unique.end());
+
+    ASSERT_EQUAL(removed.size(), removed_reference.size());
+    ASSERT_EQUAL(removed == removed_reference, true);
+    ASSERT_EQUAL(unique.size(), unique_reference.size());
+    ASSERT_EQUAL(unique == unique_reference, true);
+  }
+}
+
+void TestOmpCompactInPlaceNonTrivial()
+{
+  std::vector<std::string> input(10000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = std::to_string((i / 3) * 7919 % 1000);
+  }
+
+  TestOmpCompactInPlaceThreads(input);
+}
+DECLARE_UNITTEST(TestOmpCompactInPlaceNonTrivial);
+
+void TestOmpCompactInPlaceKeepAll()
+{
+  // no tile moves, and the scratch buffer is not allocated
+  std::vector<std::string> input(10000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = std::to_string(2 * i) + "x";
+    if(input[i].size() % 2 == 1)
+    {
+      input[i] += "y";
+    }
+  }
+
+  TestOmpCompactInPlaceThreads(input);
+}
+DECLARE_UNITTEST(TestOmpCompactInPlaceKeepAll);
+
+void TestOmpCompactLarge()
+{
+  // many elements in each tile, with a partial tile at the end; few distinct values, so
+  // that some runs of equal elements straddle the tiles
+  const std::size_t n = (1 << 17) + 3;
+
+  thrust::host_vector<int> random = unittest::random_integers<int>(n);
+  std::vector<int> input(n), stencil(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    input[i]   = random[i] & 3;
+    stencil[i] = (random[i] >> 2) & 1;
+  }
+
+  auto is_odd = [](int x) { return x % 2 == 1; };
+
+  std::vector<int> copied_reference, removed_reference, removed_by_stencil_reference, unique_reference;
+  std::vector<int> odd_reference, even_reference;
+  std::copy_if(input.begin(), input.end(), std::back_inserter(copied_reference), is_odd);
+  std::remove_copy_if(input.begin(), input.end(), std::back_inserter(removed_reference), is_odd);
+  std::unique_copy(input.begin(), input.end(), std::back_inserter(unique_reference));
+  std::partition_copy(input.begin(), input.end(), std::back_inserter(odd_reference), std::back_inserter(even_reference), is_odd);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    if(!stencil[i])
+    {
+      removed_by_stencil_reference.push_back(input[i]);
+    }
+  }
+
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    std::vector<int> result(n), other(n);
+
+    result.erase(thrust::copy_if(thrust::omp::par.num_threads(threads).sequential_cutoff(0), input.begin(), input.end(), result.begin(), is_odd),
+                 result.end());
+    ASSERT_EQUAL(true, result == copied_reference);
+
+    result.resize(n);
+    result.erase(thrust::remove_copy_if(thrust::omp::par.num_threads(threads).sequential_cutoff(0), input.begin(), input.end(), result.begin(), is_odd),
+                 result.end());
+    ASSERT_EQUAL(true, result == removed_reference);
+
+    result = input;
+    result.erase(thrust::remove_if(thrust::omp::par.num_threads(threads).sequential_cutoff(0), result.begin(), result.end(), stencil.begin(), thrust::identity<int>()),
+                 result.end());
+    ASSERT_EQUAL(true, result == removed_by_stencil_reference);
+
+    result.resize(n);
+    result.erase(thrust::unique_copy(thrust::omp::par.num_threads(threads).sequential_cutoff(0), input.begin(), input.end(), result.begin()),
+                 result.end());
+    ASSERT_EQUAL(true, result == unique_reference);
+
+    ASSERT_EQUAL(static_cast<std::ptrdiff_t>(unique_reference.size()),
+                 static_cast<std::ptrdiff_t>(thrust::unique_count(thrust::omp::par.num_threads(threads).sequential_cutoff(0), input.begin(), input.end())));
+
+    result.resize(n);
+    std::pair<std::vector<int>::iterator, std::vector<int>::iterator> ends =
+      thrust::stable_partition_copy(thrust::omp::par.num_threads(threads).sequential_cutoff(0), input.begin(), input.end(), result.begin(), other.begin(), is_odd);
+    result.erase(ends.first, result.end());
+    other.erase(ends.second, other.end());
+    ASSERT_EQUAL(true, result == odd_reference);
+    ASSERT_EQUAL(true, other == even_reference);
+  }
+}
+DECLARE_UNITTEST(TestOmpCompactLarge);
@@ -0,0 +1,118 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/functional.h>
+#include <thrust/scan.h>
+#include <thrust/transform_scan.h>
+#include <thrust/system/omp/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestOmpParInclusiveScan(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_result(n), d_result(n);
+
+  thrust::inclusive_scan(data.begin(), data.end(), h_result.begin());
+  thrust::inclusive_scan(policy, data.begin(), data.end(), d_result.begin());
+  ASSERT_EQUAL(h_result, d_result);
+}
+
+template<typename T>
+struct TestOmpParInclusiveScanPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestOmpParInclusiveScan<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestOmpParInclusiveScanPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestOmpParInclusiveScanPoliciesInstance;
+
+// the affine map x -> a * x + b, which compose associatively but not commutatively
+struct affine
+{
+  unittest::uint64_t a, b;
+
+  affine() : a(1), b(0) {}
+
+  affine(unittest::uint64_t a, unittest::uint64_t b) : a(a), b(b) {}
+
+  bool operator==(const affine &other) const
+  {
+    return a == other.a && b == other.b;
+  }
+};
+
+// applies f, then g
+struct compose_affine
+{
+  affine operator()(const affine &f, const affine &g) const
+  {
+    return affine(g.a * f.a, g.a * f.b + g.b);
+  }
+};
+
+void TestOmpScanLargeNonCommutative()
+{
+  // many elements in each tile, with a partial tile at the end
+  const size_t n = (1 << 17) + 3;
+
+  thrust::host_vector<unittest::uint64_t> a = unittest::random_integers<unittest::uint64_t>(n);
+  thrust::host_vector<unittest::uint64_t> b = unittest::random_integers<unittest::uint64_t>(n);
+  thrust::host_vector<affine> data(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    data[i] = affine(a[i], b[i]);
+  }
+
+  thrust::host_vector<affine> h_inclusive(n), h_exclusive(n);
+  thrust::inclusive_scan(data.begin(), data.end(), h_inclusive.begin(), compose_affine());
+  thrust::exclusive_scan(data.begin(), data.end(), h_exclusive.begin(), affine(3, 5), compose_affine());
+
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    thrust::host_vector<affine> d_result(n);
+
+    thrust::inclusive_scan(thrust::omp::par.num_threads(threads).sequential_cutoff(0), data.begin(), data.end(), d_result.begin(), compose_affine());
+    ASSERT_EQUAL(true, h_inclusive == d_result);
+
+    thrust::exclusive_scan(thrust::omp::par.num_threads(threads).sequential_cutoff(0), data.begin(), data.end(), d_result.begin(), affine(3, 5), compose_affine());
+    ASSERT_EQUAL(true, h_exclusive == d_result);
+
+    // in place
+    d_result = data;
+    thrust::inclusive_scan(thrust::omp::par.num_threads(threads).sequential_cutoff(0), d_result.begin(), d_result.end(), d_result.begin(), compose_affine());
+    ASSERT_EQUAL(true, h_inclusive == d_result);
+
+    d_result = data;
+    thrust::exclusive_scan(thrust::omp::par.num_threads(threads).sequential_cutoff(0), d_result.begin(), d_result.end(), d_result.begin(), affine(3, 5), compose_affine());
+    ASSERT_EQUAL(true, h_exclusive == d_result);
+  }
+}
+DECLARE_UNITTEST(TestOmpScanLargeNonCommutative);
+
+void TestOmpTransformScanLarge()
+{
+  const size_t n = (1 << 17) + 3;
+
+  thrust::host_vector<unittest::int64_t> data = unittest::random_integers<unittest::int64_t>(n);
+  thrust::host_vector<unittest::int64_t> h_inclusive(n), h_exclusive(n);
+
+  thrust::transform_inclusive_scan(data.begin(), data.end(), h_inclusive.begin(), thrust::negate<unittest::int64_t>(), thrust::plus<unittest::int64_t>());
+  thrust::transform_exclusive_scan(data.begin(), data.end(), h_exclusive.begin(), thrust::negate<unittest::int64_t>(), 11, thrust::plus<unittest::int64_t>());
+
+  // the default policy, whose sequential cutoff n exceeds
+  thrust::host_vector<unittest::int64_t> d_result(n);
+
+  thrust::transform_inclusive_scan(thrust::omp::par, data.begin(), data.end(), d_result.begin(), thrust::negate<unittest::int64_t>(), thrust::plus<unittest::int64_t>());
+  ASSERT_EQUAL(h_inclusive, d_result);
+
+  thrust::transform_exclusive_scan(thrust::omp::par, data.begin(), data.end(), d_result.begin(), thrust::negate<unittest::int64_t>(), 11, thrust::plus<unittest::int64_t>());
+  ASSERT_EQUAL(h_exclusive, d_result);
+}
+DECLARE_UNITTEST(TestOmpTransformScanLarge);
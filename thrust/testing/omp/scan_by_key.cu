@@ -0,0 +1,93 @@
+#include <unittest/unittest.h>
+
+#include <thrust/scan.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <algorithm>
+
+// keys in runs of one element, of a few and of more than a tile
+thrust::host_vector<int> scan_by_key_runs(size_t n)
+{
+  const size_t run_lengths[] = {1, 3, 1, 40000, 7, 1000, 1, 1};
+  const size_t num_run_lengths = sizeof(run_lengths) / sizeof(run_lengths[0]);
+
+  thrust::host_vector<int> keys(n);
+
+  size_t run = 0;
+  for(size_t i = 0; i < n; ++run)
+  {
+    const size_t end = std::min(n, i + run_lengths[run % num_run_lengths]);
+
+    for(; i < end; ++i)
+    {
+      keys[i] = static_cast<int>(run);
+    }
+  }
+
+  return keys;
+}
+
+void TestOmpScanByKeyLarge()
+{
+  const size_t n = (1 << 17) + 3;
+
+  thrust::host_vector<int> keys = scan_by_key_runs(n);
+  thrust::host_vector<unittest::int64_t> values = unittest::random_integers<unittest::int64_t>(n);
+
+  thrust::host_vector<unittest::int64_t> h_inclusive(n), h_exclusive(n);
+  thrust::inclusive_scan_by_key(keys.begin(), keys.end(), values.begin(), h_inclusive.begin());
+  thrust::exclusive_scan_by_key(keys.begin(), keys.end(), values.begin(), h_exclusive.begin(), unittest::int64_t(13));
+
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    thrust::host_vector<unittest::int64_t> d_result(n);
+
+    thrust::inclusive_scan_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0), keys.begin(), keys.end(), values.begin(), d_result.begin());
+    ASSERT_EQUAL(h_inclusive, d_result);
+
+    thrust::exclusive_scan_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0), keys.begin(), keys.end(), values.begin(), d_result.begin(), unittest::int64_t(13));
+    ASSERT_EQUAL(h_exclusive, d_result);
+
+    // in place
+    d_result = values;
+    thrust::inclusive_scan_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0), keys.begin(), keys.end(), d_result.begin(), d_result.begin());
+    ASSERT_EQUAL(h_inclusive, d_result);
+
+    d_result = values;
+    thrust::exclusive_scan_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0), keys.begin(), keys.end(), d_result.begin(), d_result.begin(), unittest::int64_t(13));
+    ASSERT_EQUAL(h_exclusive, d_result);
+  }
+}
+DECLARE_UNITTEST(TestOmpScanByKeyLarge);
+
+// treats the keys of four consecutive runs as equal, so that the segments differ from
+// the runs of equal keys
+struct equal_quarter
+{
+  bool operator()(int x, int y) const
+  {
+    return x / 4 == y / 4;
+  }
+};
+
+void TestOmpScanByKeyLargeBinaryPredicate()
+{
+  const size_t n = (1 << 17) + 3;
+
+  thrust::host_vector<int> keys = scan_by_key_runs(n);
+  thrust::host_vector<unittest::int64_t> values = unittest::random_integers<unittest::int64_t>(n);
+
+  thrust::host_vector<unittest::int64_t> h_inclusive(n), h_exclusive(n);
+  thrust::inclusive_scan_by_key(keys.begin(), keys.end(), values.begin(), h_inclusive.begin(), equal_quarter());
+  thrust::exclusive_scan_by_key(keys.begin(), keys.end(), values.begin(), h_exclusive.begin(), unittest::int64_t(0), equal_quarter());
+
+  // the default policy, whose sequential cutoff n exceeds
+  thrust::host_vector<unittest::int64_t> d_result(n);
+
+  thrust::inclusive_scan_by_key(thrust::omp::par, keys.begin(), keys.end(), values.begin(), d_result.begin(), equal_quarter());
+  ASSERT_EQUAL(h_inclusive, d_result);
+
+  thrust::exclusive_scan_by_key(thrust::omp::par, keys.begin(), keys.end(), values.begin(), d_result.begin(), unittest::int64_t(0), equal_quarter());
+  ASSERT_EQUAL(h_exclusive, d_result);
+}
+DECLARE_UNITTEST(TestOmpScanByKeyLargeBinaryPredicate);
@@ -0,0 +1,77 @@
+#include <unittest/unittest.h>
+
+#include <thrust/functional.h>
+#include <thrust/set_operations.h>
+#include <thrust/sort.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+template<typename Compare>
+void TestOmpSetOperationsLargeInputs(const thrust::host_vector<int> &a, const thrust::host_vector<int> &b, Compare comp)
+{
+  std::vector<int> union_ref, intersection_ref, difference_ref, symmetric_difference_ref;
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(union_ref), comp);
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(intersection_ref), comp);
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(difference_ref), comp);
+  std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(symmetric_difference_ref), comp);
+
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    std::vector<int> result(a.size() + b.size());
+
+    result.erase(thrust::set_union(thrust::omp::par.num_threads(threads).sequential_cutoff(0), a.begin(), a.end(), b.begin(), b.end(), result.begin(), comp), result.end());
+    ASSERT_EQUAL(true, result == union_ref);
+
+    result.resize(a.size() + b.size());
+    result.erase(thrust::set_intersection(thrust::omp::par.num_threads(threads).sequential_cutoff(0), a.begin(), a.end(), b.begin(), b.end(), result.begin(), comp), result.end());
+    ASSERT_EQUAL(true, result == intersection_ref);
+
+    result.resize(a.size() + b.size());
+    result.erase(thrust::set_difference(thrust::omp::par.num_threads(threads).sequential_cutoff(0), a.begin(), a.end(), b.begin(), b.end(), result.begin(), comp), result.end());
+    ASSERT_EQUAL(true, result == difference_ref);
+
+    result.resize(a.size() + b.size());
+    result.erase(thrust::set_symmetric_difference(thrust::omp::par.num_threads(threads).sequential_cutoff(0), a.begin(), a.end(), b.begin(), b.end(), result.begin(), comp), result.end());
+    ASSERT_EQUAL(true, result == symmetric_difference_ref);
+  }
+}
+
+void TestOmpSetOperationsLarge()
+{
+  const size_t n1 = 70001, n2 = 50003;
+
+  // few distinct values, so that runs of equal elements straddle the tiles
+  thrust::host_vector<int> a = unittest::random_integers<int>(n1);
+  thrust::host_vector<int> b = unittest::random_integers<int>(n2);
+  for(size_t i = 0; i < n1; ++i)
+  {
+    a[i] %= 1000;
+  }
+  for(size_t i = 0; i < n2; ++i)
+  {
+    b[i] %= 1000;
+  }
+
+  thrust::sort(a.begin(), a.end());
+  thrust::sort(b.begin(), b.end());
+  TestOmpSetOperationsLargeInputs(a, b, thrust::less<int>());
+
+  thrust::sort(a.begin(), a.end(), thrust::greater<int>());
+  thrust::sort(b.begin(), b.end(), thrust::greater<int>());
+  TestOmpSetOperationsLargeInputs(a, b, thrust::greater<int>());
+
+  // every element of a precedes every element of b, so that each tile falls in one input
+  for(size_t i = 0; i < n1; ++i)
+  {
+    a[i] = static_cast<int>(i);
+  }
+  for(size_t i = 0; i < n2; ++i)
+  {
+    b[i] = static_cast<int>(n1 + i);
+  }
+  TestOmpSetOperationsLargeInputs(a, b, thrust::less<int>());
+}
+DECLARE_UNITTEST(TestOmpSetOperationsLarge);
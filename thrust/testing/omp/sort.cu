@@ -0,0 +1,267 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/functional.h>
+#include <thrust/sort.h>
+#include <thrust/system/detail/internal/index_sort.h>
+#include <thrust/system/omp/execution_policy.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+template<typename Key>
+void TestOmpStableSortByKeyThreads(const std::vector<Key> &input)
+{
+  const std::size_t n = input.size();
+
+  std::vector<std::pair<Key, std::size_t> > reference(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    reference[i] = std::make_pair(input[i], i);
+  }
+  std::stable_sort(reference.begin(), reference.end(),
+                   [](const std::pair<Key, std::size_t> &a, const std::pair<Key, std::size_t> &b) { return a.first < b.first; });
+
+  // a comparison which is not less or greater, so that primitive keys take the merge sort
+  auto comp = [](const Key &a, const Key &b) { return a < b; };
+
+  // two threads merge once, from the buffer; three and four threads merge twice, in place
+  for(int threads = 1; threads <= 4; ++threads)
+  {
+    std::vector<Key> sorted = input;
+    thrust::stable_sort(thrust::omp::par.num_threads(threads).sequential_cutoff(0), sorted.begin(), sorted.end(), comp);
+
+    std::vector<Key>         keys = input;
+    std::vector<std::size_t> values(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      values[i] = i;
+    }
+    thrust::stable_sort_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0), keys.begin(), keys.end(), values.begin(), comp);
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      ASSERT_EQUAL(sorted[i] == reference[i].first, true);
+      ASSERT_EQUAL(keys[i] == reference[i].first, true);
+      ASSERT_EQUAL(values[i], reference[i].second);
+    }
+  }
+}
+
+void TestOmpStableSortTrivialKeys()
+{
+  std::vector<double> input(10000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = static_cast<double>((i * 7919) % 1000);
+  }
+
+  TestOmpStableSortByKeyThreads(input);
+}
+DECLARE_UNITTEST(TestOmpStableSortTrivialKeys);
+
+void TestOmpStableSortNonTrivialKeys()
+{
+  std::vector<std::string> input(10000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = std::to_string((i * 7919) % 1000);
+  }
+
+  TestOmpStableSortByKeyThreads(input);
+}
+DECLARE_UNITTEST(TestOmpStableSortNonTrivialKeys);
+
+template<typename T, typename Policy>
+void TestOmpParStableSort(Policy policy, size_t n)
+{
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> d_data = h_data;
+
+  thrust::stable_sort(h_data.begin(), h_data.end());
+  thrust::stable_sort(policy, d_data.begin(), d_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+}
+
+template<typename T>
+struct TestOmpParStableSortPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestOmpParStableSort<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestOmpParStableSortPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestOmpParStableSortPoliciesInstance;
+
+template<typename T>
+struct less_than
+{
+  bool operator()(T x, T y) const
+  {
+    return x < y;
+  }
+};
+
+template<typename T, typename Value>
+void TestOmpParSortByKeyValues(const size_t n)
+{
+  // few distinct keys, so that the order of equal keys is checked
+  thrust::host_vector<T> keys = unittest::random_integers<T>(n);
+  thrust::host_vector<Value> values(n);
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    keys[i] = keys[i] % 64;
+    values[i] = Value(static_cast<T>(i));
+  }
+
+  thrust::host_vector<T> h_keys = keys, d_keys = keys;
+  thrust::host_vector<Value> h_values = values, d_values = values;
+
+  thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin());
+  thrust::stable_sort_by_key(thrust::omp::par.num_threads(3).sequential_cutoff(0), d_keys.begin(), d_keys.end(), d_values.begin());
+
+  ASSERT_EQUAL(h_keys, d_keys);
+  ASSERT_EQUAL_QUIET(h_values, d_values);
+
+  // the merge sort takes the comparisons the radix sort does not
+  h_keys = d_keys = keys;
+  h_values = d_values = values;
+
+  thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin(), less_than<T>());
+  thrust::stable_sort_by_key(thrust::omp::par.num_threads(3).sequential_cutoff(0), d_keys.begin(), d_keys.end(), d_values.begin(), less_than<T>());
+
+  ASSERT_EQUAL(h_keys, d_keys);
+  ASSERT_EQUAL_QUIET(h_values, d_values);
+}
+
+template<typename T>
+struct TestOmpParSortByKeyLargeValues
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::index_sort_value_size;
+    using thrust::system::detail::internal::use_index_sort;
+
+    // the largest values carried through the sort, and the smallest which follow their keys by index
+    typedef FixedVector<T, index_sort_value_size / sizeof(T)>     carried_value;
+    typedef FixedVector<T, index_sort_value_size / sizeof(T) + 1> indexed_value;
+
+    ASSERT_EQUAL(false, use_index_sort<carried_value>::value);
+    ASSERT_EQUAL(true,  use_index_sort<indexed_value>::value);
+
+    TestOmpParSortByKeyValues<T, carried_value>(n);
+    TestOmpParSortByKeyValues<T, indexed_value>(n);
+  }
+};
+VariableUnitTest<TestOmpParSortByKeyLargeValues, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestOmpParSortByKeyLargeValuesInstance;
+
+void TestOmpStableSortLargeManyThreads()
+{
+  // tiles of many elements; five to eight threads leave a tile unpaired at some level and
+  // merge three times
+  const std::size_t n = (1 << 17) + 3;
+
+  // few distinct keys, so that the order of equal keys is checked
+  thrust::host_vector<unittest::uint32_t> input = unittest::random_integers<unittest::uint32_t>(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    input[i] %= 256;
+  }
+
+  std::vector<std::pair<unittest::uint32_t, std::size_t> > reference(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    reference[i] = std::make_pair(input[i], i);
+  }
+  std::stable_sort(reference.begin(), reference.end(),
+                   [](const std::pair<unittest::uint32_t, std::size_t> &a, const std::pair<unittest::uint32_t, std::size_t> &b) { return a.first < b.first; });
+
+  // not less or greater, so that the keys take the merge sort rather than the radix sort
+  auto comp = [](unittest::uint32_t a, unittest::uint32_t b) { return a < b; };
+
+  for(int threads = 5; threads <= 8; ++threads)
+  {
+    thrust::host_vector<unittest::uint32_t> sorted = input;
+    thrust::stable_sort(thrust::omp::par.num_threads(threads).sequential_cutoff(0), sorted.begin(), sorted.end(), comp);
+
+    thrust::host_vector<unittest::uint32_t> keys = input;
+    thrust::host_vector<std::size_t>         values(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      values[i] = i;
+    }
+    thrust::stable_sort_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0), keys.begin(), keys.end(), values.begin(), comp);
+
+    bool matches = true;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      matches = matches && sorted[i] == reference[i].first && keys[i] == reference[i].first && values[i] == reference[i].second;
+    }
+
+    ASSERT_EQUAL(true, matches);
+  }
+}
+DECLARE_UNITTEST(TestOmpStableSortLargeManyThreads);
+
+template<typename Key, typename Compare>
+void TestOmpRadixSortLargeKeys(Compare comp)
+{
+  // above the size from which the radix sort runs in parallel
+  const std::size_t n = (1 << 16) + 5;
+
+  thrust::host_vector<unittest::int64_t> random = unittest::random_integers<unittest::int64_t>(n);
+
+  // both signs, and for the narrow keys, many equal keys whose order is checked
+  std::vector<std::pair<Key, std::size_t> > reference(n);
+  thrust::host_vector<Key> input(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    input[i]     = static_cast<Key>(random[i] % 100000) / static_cast<Key>(4);
+    reference[i] = std::make_pair(input[i], i);
+  }
+  std::stable_sort(reference.begin(), reference.end(),
+                   [comp](const std::pair<Key, std::size_t> &a, const std::pair<Key, std::size_t> &b) { return comp(a.first, b.first); });
+
+  for(int threads = 1; threads <= 4; ++threads)
+  {
+    thrust::host_vector<Key> sorted = input;
+    thrust::stable_sort(thrust::omp::par.num_threads(threads).sequential_cutoff(0), sorted.begin(), sorted.end(), comp);
+
+    thrust::host_vector<Key>         keys = input;
+    thrust::host_vector<std::size_t> values(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      values[i] = i;
+    }
+    thrust::stable_sort_by_key(thrust::omp::par.num_threads(threads).sequential_cutoff(0), keys.begin(), keys.end(), values.begin(), comp);
+
+    bool matches = true;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      matches = matches && sorted[i] == reference[i].first && keys[i] == reference[i].first && values[i] == reference[i].second;
+    }
+
+    ASSERT_EQUAL(true, matches);
+  }
+}
+
+void TestOmpRadixSortLarge()
+{
+  TestOmpRadixSortLargeKeys<signed char>(thrust::less<signed char>());
+  TestOmpRadixSortLargeKeys<short>(thrust::greater<short>());
+  TestOmpRadixSortLargeKeys<unittest::int32_t>(thrust::less<unittest::int32_t>());
+  TestOmpRadixSortLargeKeys<unittest::uint32_t>(thrust::greater<unittest::uint32_t>());
+  TestOmpRadixSortLargeKeys<unittest::int64_t>(thrust::greater<unittest::int64_t>());
+  TestOmpRadixSortLargeKeys<float>(thrust::less<float>());
+  TestOmpRadixSortLargeKeys<double>(thrust::greater<double>());
+}
+DECLARE_UNITTEST(TestOmpRadixSortLarge);
@@ -2,6 +2,7 @@
 
 #include <map>
 #include <limits>
+#include <vector>
 #include <thrust/random.h>
 #include <thrust/sequence.h>
 #include <thrust/shuffle.h>
@@ -9,6 +10,11 @@
 #include <thrust/scatter.h>
 #include <unittest/unittest.h>
 
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/shuffle.h>
+#endif
+
 // Functions for performing statistical tests of randomness
 // From NIST-Statistical-Test-Suite
 // Licence:
@@ -371,6 +377,15 @@ void TestHostDeviceIdentical(size_t m) {
   thrust::shuffle(host_result.begin(), host_result.end(), host_g);
   thrust::shuffle(device_result.begin(), device_result.end(), device_g);
 
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+  // the host parallel backends shuffle inputs larger than a bucket in buckets rather than
+  // with the Feistel bijection of the sequential host, so they only agree on the elements
+  if (m > thrust::system::detail::internal::shuffle_bucket_size(sizeof(T))) {
+    thrust::sort(host_result.begin(), host_result.end());
+    thrust::sort(device_result.begin(), device_result.end());
+  }
+#endif
+
   ASSERT_EQUAL(device_result, host_result);
 }
 DECLARE_VARIABLE_UNITTEST(TestHostDeviceIdentical);
@@ -500,6 +515,144 @@ void TestShuffleUniformPermutation() {
 }
 DECLARE_VECTOR_UNITTEST(TestShuffleUniformPermutation);
 
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP || THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+// the four steps of the bucketed shuffle of the host parallel backends, taken by one thread
+// with buckets of the given size, so that small inputs fall into several buckets
+template <typename T>
+thrust::host_vector<T> BucketShuffle(const thrust::host_vector<T> &input, uint64_t bucket_size,
+                                     thrust::default_random_engine &g) {
+  using thrust::system::detail::internal::bucket_shuffle;
+  using thrust::system::detail::internal::uniform_decomposition;
+
+  const long n = static_cast<long>(input.size());
+
+  bucket_shuffle shuffler(n, bucket_size, g);
+
+  const long num_buckets = static_cast<long>(shuffler.num_buckets());
+  const long num_blocks = static_cast<long>(shuffler.num_blocks());
+
+  uniform_decomposition<long> blocks(n, 1, num_blocks);
+
+  std::vector<long> counts(num_blocks * num_buckets);
+  std::vector<long> bucket_begin(num_buckets + 1);
+  std::vector<T> buffer(n);
+  thrust::host_vector<T> result(n);
+
+  for (long i = 0; i < num_blocks; i++) {
+    thrust::system::detail::internal::count_buckets(shuffler, blocks[i].begin(), blocks[i].end(), counts.data() + i * num_buckets);
+  }
+
+  thrust::system::detail::internal::scan_buckets(shuffler, counts.data(), bucket_begin.data());
+
+  for (long i = 0; i < num_blocks; i++) {
+    thrust::system::detail::internal::scatter_buckets(shuffler, input.begin(), blocks[i].begin(), blocks[i].end(), buffer.data(), counts.data() + i * num_buckets);
+  }
+
+  for (long b = 0; b < num_buckets; b++) {
+    thrust::system::detail::internal::shuffle_bucket(shuffler, buffer.data(), bucket_begin.data(), b, result.begin());
+  }
+
+  return result;
+}
+
+// as TestShuffleUniformPermutation, with five elements in three buckets
+void TestShuffleBucketUniformPermutation() {
+  typedef int T;
+
+  size_t m = 5;
+  size_t num_samples = 1000;
+  size_t total_permutations = 1 * 2 * 3 * 4 * 5;
+  std::map<thrust::host_vector<T>, size_t, vector_compare> permutation_counts;
+  thrust::host_vector<T> sequence(m);
+  thrust::sequence(sequence.begin(), sequence.end(), T(0));
+  thrust::default_random_engine g(0xD5);
+  for (auto i = 0ull; i < num_samples; i++) {
+    permutation_counts[BucketShuffle(sequence, 2, g)]++;
+  }
+
+  ASSERT_EQUAL(permutation_counts.size(), total_permutations);
+
+  double chi_squared = 0.0;
+  double expected_count = static_cast<double>(num_samples) / total_permutations;
+  for (auto kv : permutation_counts) {
+    chi_squared += std::pow(expected_count - kv.second, 2) / expected_count;
+  }
+  double p_score = CephesFunctions::cephes_igamc(
+      (double)(total_permutations - 1) / 2.0, chi_squared / 2.0);
+  ASSERT_GREATER(p_score, 0.01);
+}
+DECLARE_UNITTEST(TestShuffleBucketUniformPermutation);
+
+// more buckets than blocks, which share the buckets among them
+void TestShuffleBucketManyBuckets() {
+  typedef int T;
+
+  const size_t m = 10007;
+  thrust::host_vector<T> sequence(m);
+  thrust::sequence(sequence.begin(), sequence.end(), T(0));
+  thrust::default_random_engine g(0xD5);
+
+  thrust::system::detail::internal::bucket_shuffle shuffler(m, 3, g);
+  ASSERT_EQUAL(shuffler.num_blocks(), thrust::system::detail::internal::shuffle_max_blocks);
+  ASSERT_EQUAL(shuffler.num_buckets() > shuffler.num_blocks(), true);
+
+  thrust::host_vector<T> shuffled = BucketShuffle(sequence, 3, g);
+  ASSERT_EQUAL(shuffled == sequence, false);
+
+  thrust::sort(shuffled.begin(), shuffled.end());
+  ASSERT_EQUAL(shuffled, sequence);
+}
+DECLARE_UNITTEST(TestShuffleBucketManyBuckets);
+
+// an input of several buckets, which the backend shuffles in buckets
+void TestShuffleSeveralBuckets() {
+  typedef int T;
+
+  const size_t m = 3 * thrust::system::detail::internal::shuffle_bucket_size(sizeof(T)) + 7;
+  thrust::device_vector<T> sequence(m);
+  thrust::sequence(sequence.begin(), sequence.end(), T(0));
+  thrust::default_random_engine g(0xD5);
+
+  thrust::device_vector<T> shuffled(m);
+  thrust::shuffle_copy(sequence.begin(), sequence.end(), shuffled.begin(), g);
+  ASSERT_EQUAL(shuffled == sequence, false);
+
+  thrust::device_vector<T> in_place = sequence;
+  g.seed(0xD5);
+  thrust::shuffle(in_place.begin(), in_place.end(), g);
+  ASSERT_EQUAL(in_place, shuffled);
+
+  thrust::sort(shuffled.begin(), shuffled.end());
+  ASSERT_EQUAL(shuffled, sequence);
+}
+DECLARE_UNITTEST(TestShuffleSeveralBuckets);
+
+// the permutation of a seed does not depend on the machine, such as the size of its caches
+void TestShuffleSeveralBucketsGolden() {
+  typedef unsigned int T;
+
+  const size_t m = 2 * thrust::system::detail::internal::shuffle_bucket_size(sizeof(T)) + 17;
+  thrust::device_vector<T> shuffled(m);
+  thrust::sequence(shuffled.begin(), shuffled.end(), T(0));
+  thrust::default_random_engine g(0xD5);
+  thrust::shuffle(shuffled.begin(), shuffled.end(), g);
+
+  thrust::host_vector<T> h_shuffled = shuffled;
+
+  uint64_t checksum = 0;
+  for (size_t i = 0; i < m; i++) {
+    checksum = checksum * UINT64_C(1099511628211) + h_shuffled[i];
+  }
+
+  const T golden_first[] = {108154, 169198, 230698, 82898, 254004, 242567, 225054, 116063};
+  for (size_t i = 0; i < sizeof(golden_first) / sizeof(golden_first[0]); i++) {
+    ASSERT_EQUAL(h_shuffled[i], golden_first[i]);
+  }
+  ASSERT_EQUAL(checksum, UINT64_C(118118995162190074));
+}
+DECLARE_UNITTEST(TestShuffleSeveralBucketsGolden);
+#endif
+
 template <typename Vector>
 void TestShuffleEvenSpacingBetweenOccurances() {
   typedef typename Vector::value_type T;
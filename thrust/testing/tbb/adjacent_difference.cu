@@ -0,0 +1,37 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/adjacent_difference.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestTbbParAdjacentDifference(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_result(n), d_result(n);
+
+  thrust::adjacent_difference(data.begin(), data.end(), h_result.begin());
+  thrust::adjacent_difference(policy, data.begin(), data.end(), d_result.begin());
+  ASSERT_EQUAL(h_result, d_result);
+
+  // in place, each tile reads the last element of the one before it
+  d_result = data;
+  thrust::adjacent_difference(policy, d_result.begin(), d_result.end(), d_result.begin());
+  ASSERT_EQUAL(h_result, d_result);
+}
+
+template<typename T>
+struct TestTbbParAdjacentDifferencePolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParAdjacentDifference<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParAdjacentDifferencePolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParAdjacentDifferencePoliciesInstance;
@@ -0,0 +1,128 @@
+#include <thrust/detail/config.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <unittest/unittest.h>
+
+#include <thrust/async/copy.h>
+#include <thrust/async/for_each.h>
+#include <thrust/async/reduce.h>
+#include <thrust/async/scan.h>
+#include <thrust/async/sort.h>
+#include <thrust/async/transform.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sequence.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
+#include <thrust/system/tbb/execution_policy.h>
+#include <thrust/system/tbb/future.h>
+
+#include <stdexcept>
+
+
+template<typename T>
+struct times_three
+{
+  T operator()(T x) const
+  {
+    return 3 * x;
+  }
+};
+
+
+struct throw_on_visit
+{
+  template<typename T>
+  void operator()(T &) const
+  {
+    throw std::runtime_error("visited");
+  }
+};
+
+
+void TestTbbAsyncReduce()
+{
+  thrust::host_vector<int> data(unittest::random_integers<int>(100000));
+
+  auto f = thrust::async::reduce(thrust::tbb::par, data.begin(), data.end(), 0, thrust::plus<int>());
+
+  const int expected = thrust::reduce(data.begin(), data.end(), 0, thrust::plus<int>());
+
+  ASSERT_EQUAL(true, f.valid_content());
+  ASSERT_EQUAL(expected, f.get());
+  ASSERT_EQUAL(true, f.ready());
+  ASSERT_EQUAL(expected, f.extract());
+  ASSERT_EQUAL(false, f.valid_stream());
+}
+DECLARE_UNITTEST(TestTbbAsyncReduce);
+
+
+void TestTbbAsyncAfter()
+{
+  const size_t n = 100000;
+
+  thrust::host_vector<int> data(unittest::random_integers<int>(n));
+  thrust::host_vector<int> result(n);
+
+  thrust::host_vector<int> expected(n);
+  thrust::transform(data.begin(), data.end(), expected.begin(), times_three<int>());
+  thrust::sort(expected.begin(), expected.end());
+  thrust::inclusive_scan(expected.begin(), expected.end(), expected.begin());
+
+  auto e0 = thrust::async::transform(thrust::tbb::par, data.begin(), data.end(), result.begin(), times_three<int>());
+  auto e1 = thrust::async::sort(thrust::tbb::par.after(e0), result.begin(), result.end());
+  auto e2 = thrust::async::inclusive_scan(thrust::tbb::par.after(e1), result.begin(), result.end(), result.begin());
+  auto f  = thrust::async::reduce(thrust::tbb::par.after(e2), result.begin(), result.end(), 0, thrust::maximum<int>());
+
+  // the dependencies are moved into each algorithm
+  ASSERT_EQUAL(false, e0.valid_stream());
+  ASSERT_EQUAL(false, e1.valid_stream());
+  ASSERT_EQUAL(false, e2.valid_stream());
+
+  ASSERT_EQUAL(thrust::reduce(expected.begin(), expected.end(), 0, thrust::maximum<int>()), f.get());
+  ASSERT_EQUAL(expected, result);
+}
+DECLARE_UNITTEST(TestTbbAsyncAfter);
+
+
+void TestTbbAsyncWhenAll()
+{
+  const size_t n = 100000;
+
+  thrust::host_vector<int> data(n);
+  thrust::sequence(data.begin(), data.end());
+
+  thrust::host_vector<int> copy(n);
+  thrust::host_vector<int> scan(n);
+
+  auto e0 = thrust::async::copy(thrust::tbb::par, data.begin(), data.end(), copy.begin());
+  auto e1 = thrust::async::exclusive_scan(thrust::tbb::par, data.begin(), data.end(), scan.begin(), 1, thrust::plus<int>());
+
+  auto e = thrust::when_all(e0, e1);
+  e.wait();
+
+  ASSERT_EQUAL(true, e.ready());
+  ASSERT_EQUAL(data, copy);
+
+  thrust::host_vector<int> expected(n);
+  thrust::exclusive_scan(data.begin(), data.end(), expected.begin(), 1, thrust::plus<int>());
+  ASSERT_EQUAL(expected, scan);
+}
+DECLARE_UNITTEST(TestTbbAsyncWhenAll);
+
+
+void TestTbbAsyncException()
+{
+  thrust::host_vector<int> data(10);
+
+  auto e0 = thrust::async::for_each(thrust::tbb::par, data.begin(), data.end(), throw_on_visit());
+  auto e1 = thrust::async::sort(thrust::tbb::par.after(e0), data.begin(), data.end());
+
+  // the exception of a dependency is rethrown by each dependent
+  ASSERT_THROWS(e1.wait(), std::runtime_error);
+}
+DECLARE_UNITTEST(TestTbbAsyncException);
+
+#endif // C++14
+
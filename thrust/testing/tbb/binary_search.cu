@@ -0,0 +1,83 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/binary_search.h>
+#include <thrust/copy.h>
+#include <thrust/sort.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestTbbParSortedSearch(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+  thrust::sort(data.begin(), data.end());
+
+  // half of the values are found
+  thrust::host_vector<T> values = unittest::random_integers<T>(n);
+  thrust::copy(data.begin(), data.begin() + n / 2, values.begin());
+  thrust::host_vector<size_t> h_bounds(n), d_bounds(n);
+
+  // the searches take the merge path when the values are sorted
+  for(int sorted = 0; sorted < 2; ++sorted)
+  {
+    thrust::lower_bound(data.begin(), data.end(), values.begin(), values.end(), h_bounds.begin());
+    thrust::lower_bound(policy, data.begin(), data.end(), values.begin(), values.end(), d_bounds.begin());
+    ASSERT_EQUAL(h_bounds, d_bounds);
+
+    thrust::upper_bound(data.begin(), data.end(), values.begin(), values.end(), h_bounds.begin());
+    thrust::upper_bound(policy, data.begin(), data.end(), values.begin(), values.end(), d_bounds.begin());
+    ASSERT_EQUAL(h_bounds, d_bounds);
+
+    thrust::binary_search(data.begin(), data.end(), values.begin(), values.end(), h_bounds.begin());
+    thrust::binary_search(policy, data.begin(), data.end(), values.begin(), values.end(), d_bounds.begin());
+    ASSERT_EQUAL(h_bounds, d_bounds);
+
+    thrust::sort(values.begin(), values.end());
+  }
+}
+
+template<typename T>
+struct TestTbbParSortedSearchPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParSortedSearch<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParSortedSearchPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParSortedSearchPoliciesInstance;
+
+void TestTbbParSortedSearchFewValues()
+{
+  using thrust::system::detail::internal::use_merge_search;
+
+  // few values are probed for even when sorted, many are merged
+  ASSERT_EQUAL(use_merge_search<long>(1l << 30, 5000), false);
+  ASSERT_EQUAL(use_merge_search<long>(1l << 20, 1l << 20), true);
+  ASSERT_EQUAL(use_merge_search<long>(1l << 10, 1l << 20), true);
+
+  const size_t n = 1 << 20, m = 5000;
+
+  thrust::host_vector<int> data = unittest::random_integers<int>(n);
+  thrust::sort(data.begin(), data.end());
+
+  thrust::host_vector<int> values = unittest::random_integers<int>(m);
+  thrust::copy(data.begin(), data.begin() + m / 2, values.begin());
+  thrust::sort(values.begin(), values.end());
+
+  thrust::host_vector<size_t> h_bounds(m), d_bounds(m);
+
+  thrust::lower_bound(data.begin(), data.end(), values.begin(), values.end(), h_bounds.begin());
+  thrust::lower_bound(thrust::tbb::par.sequential_cutoff(0), data.begin(), data.end(), values.begin(), values.end(), d_bounds.begin());
+  ASSERT_EQUAL(h_bounds, d_bounds);
+
+  thrust::upper_bound(data.begin(), data.end(), values.begin(), values.end(), h_bounds.begin());
+  thrust::upper_bound(thrust::tbb::par.sequential_cutoff(0), data.begin(), data.end(), values.begin(), values.end(), d_bounds.begin());
+  ASSERT_EQUAL(h_bounds, d_bounds);
+}
+DECLARE_UNITTEST(TestTbbParSortedSearchFewValues);
@@ -0,0 +1,39 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/count.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T>
+struct is_odd
+{
+  bool operator()(T x) const
+  {
+    return (static_cast<unsigned int>(x) & 1) != 0;
+  }
+};
+
+template<typename T, typename Policy>
+void TestTbbParCountIf(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+
+  ASSERT_EQUAL(thrust::count_if(policy, data.begin(), data.end(), is_odd<T>()),
+               thrust::count_if(data.begin(), data.end(), is_odd<T>()));
+}
+
+template<typename T>
+struct TestTbbParCountIfPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParCountIf<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParCountIfPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParCountIfPoliciesInstance;
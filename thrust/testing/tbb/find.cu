@@ -0,0 +1,38 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/find.h>
+#include <thrust/sequence.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestTbbParFind(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data(n);
+  thrust::sequence(data.begin(), data.end());
+
+  // the first match cancels the search of the blocks after it; the last value is not found
+  for(size_t i = 0; i < 4; ++i)
+  {
+    const T x = static_cast<T>((n * i) / 3);
+
+    ASSERT_EQUAL(thrust::find(policy, data.begin(), data.end(), x) - data.begin(),
+                 thrust::find(data.begin(), data.end(), x) - data.begin());
+  }
+}
+
+template<typename T>
+struct TestTbbParFindPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParFind<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParFindPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParFindPoliciesInstance;
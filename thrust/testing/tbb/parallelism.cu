@@ -0,0 +1,368 @@
+#include <unittest/unittest.h>
+
+#include <thrust/for_each.h>
+#include <thrust/memory.h>
+#include <thrust/random.h>
+#include <thrust/reduce.h>
+#include <thrust/sort.h>
+#include <thrust/sequence.h>
+#include <thrust/shuffle.h>
+#include <thrust/transform.h>
+#include <thrust/uninitialized_fill.h>
+#include <thrust/system/detail/internal/temporary_pool.h>
+#include <thrust/system/tbb/execution_policy.h>
+#include <thrust/system/tbb/vector.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <tbb/task_arena.h>
+
+
+struct record_calling_thread
+{
+  std::thread::id caller;
+
+  template<typename T>
+  void operator()(T &x) const
+  {
+    x = (std::this_thread::get_id() == caller) ? 1 : 0;
+  }
+};
+
+
+void TestTbbParSequentialCutoff()
+{
+  thrust::host_vector<int> v(1000, 0);
+
+  record_calling_thread f = {std::this_thread::get_id()};
+
+  // below the cutoff, every element is visited by the calling thread
+  thrust::for_each(thrust::tbb::par.sequential_cutoff(1001), v.begin(), v.end(), f);
+
+  ASSERT_EQUAL(v, thrust::host_vector<int>(1000, 1));
+
+#if THRUST_TBB_SEQUENTIAL_CUTOFF > 1
+  thrust::host_vector<int> w(THRUST_TBB_SEQUENTIAL_CUTOFF - 1, 0);
+
+  thrust::for_each(thrust::tbb::par, w.begin(), w.end(), f);
+
+  ASSERT_EQUAL(w, thrust::host_vector<int>(THRUST_TBB_SEQUENTIAL_CUTOFF - 1, 1));
+#endif
+}
+DECLARE_UNITTEST(TestTbbParSequentialCutoff);
+
+
+struct record_max_concurrency
+{
+  template<typename T>
+  void operator()(T &x) const
+  {
+    x = ::tbb::this_task_arena::max_concurrency();
+  }
+};
+
+
+void TestTbbParArena()
+{
+  thrust::host_vector<int> v(1000, 0);
+
+  ::tbb::task_arena arena(2);
+
+  thrust::for_each(thrust::tbb::par.arena(arena).sequential_cutoff(0), v.begin(), v.end(), record_max_concurrency());
+
+  ASSERT_EQUAL(v, thrust::host_vector<int>(1000, 2));
+
+  thrust::for_each(thrust::tbb::par.sequential_cutoff(0).arena(arena).partitioner(thrust::tbb::partitioner_static), v.begin(), v.end(), record_max_concurrency());
+
+  ASSERT_EQUAL(v, thrust::host_vector<int>(1000, 2));
+}
+DECLARE_UNITTEST(TestTbbParArena);
+
+
+template<typename T>
+struct TestTbbParAffinity
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+    thrust::host_vector<T> d_data = h_data;
+
+    thrust::tbb::affinity_handle affinity;
+
+    // repeated calls over the same range share the handle
+    for(int i = 0; i < 3; ++i)
+    {
+      thrust::transform(h_data.begin(), h_data.end(), h_data.begin(), thrust::negate<T>());
+      thrust::transform(thrust::tbb::par.affinity(affinity).sequential_cutoff(0), d_data.begin(), d_data.end(), d_data.begin(), thrust::negate<T>());
+      ASSERT_EQUAL(h_data, d_data);
+
+      ASSERT_EQUAL(thrust::reduce(thrust::tbb::par.affinity(affinity).sequential_cutoff(0), d_data.begin(), d_data.end()),
+                   thrust::reduce(h_data.begin(), h_data.end()));
+    }
+  }
+};
+VariableUnitTest<TestTbbParAffinity, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParAffinityInstance;
+
+
+template<typename T>
+struct TestTbbParMergeSort
+{
+  void operator()(const size_t n)
+  {
+    // large keys make for small leaves, and thus for a deep tree of merges
+    typedef FixedVector<T,16> key_type;
+
+    thrust::host_vector<T> data = unittest::random_integers<T>(n);
+    thrust::host_vector<key_type> h_keys(n);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      h_keys[i] = key_type(data[i]);
+    }
+
+    thrust::host_vector<key_type> d_keys = h_keys;
+
+    ::tbb::task_arena arena(3);
+
+    thrust::stable_sort(h_keys.begin(), h_keys.end());
+    thrust::stable_sort(thrust::tbb::par.arena(arena).sequential_cutoff(0), d_keys.begin(), d_keys.end());
+
+    ASSERT_EQUAL_QUIET(h_keys, d_keys);
+  }
+};
+VariableUnitTest<TestTbbParMergeSort, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParMergeSortInstance;
+
+void TestTbbParShuffleIsReproducible()
+{
+  // large enough to fall into several buckets
+  const size_t n = 3 * (1 << 16) + 17;
+
+  thrust::host_vector<unsigned int> sequence(n);
+  thrust::sequence(sequence.begin(), sequence.end());
+
+  thrust::host_vector<unsigned int> expected = sequence;
+  thrust::default_random_engine g(0xD5);
+  thrust::shuffle(thrust::tbb::par.sequential_cutoff(n + 1), expected.begin(), expected.end(), g);
+
+  ASSERT_EQUAL(false, expected == sequence);
+
+  // the permutation does not depend on the number of threads
+  for(int threads = 1; threads < 6; threads += 2)
+  {
+    ::tbb::task_arena arena(threads);
+
+    thrust::host_vector<unsigned int> shuffled = sequence;
+    g.seed(0xD5);
+    thrust::shuffle(thrust::tbb::par.arena(arena).sequential_cutoff(0), shuffled.begin(), shuffled.end(), g);
+    ASSERT_EQUAL(expected, shuffled);
+
+    thrust::host_vector<unsigned int> copied(n);
+    g.seed(0xD5);
+    thrust::shuffle_copy(thrust::tbb::par.arena(arena).partitioner(thrust::tbb::partitioner_simple), sequence.begin(), sequence.end(), copied.begin(), g);
+    ASSERT_EQUAL(expected, copied);
+  }
+
+  thrust::sort(expected.begin(), expected.end());
+  ASSERT_EQUAL(sequence, expected);
+}
+DECLARE_UNITTEST(TestTbbParShuffleIsReproducible);
+
+void TestTbbParTemporaryStorageIsPooled()
+{
+  thrust::tbb::release_temporary_storage();
+
+  // a buffer reuses the storage just returned to its size class
+  const std::ptrdiff_t sizes[] = {100, 3 << 18, 5 << 17};
+
+  for(std::ptrdiff_t n : sizes)
+  {
+    auto first = thrust::get_temporary_buffer<int>(thrust::tbb::par, n);
+    ASSERT_EQUAL(n, first.second);
+    thrust::return_temporary_buffer(thrust::tbb::par, first.first, first.second);
+
+    auto second = thrust::get_temporary_buffer<int>(thrust::tbb::par, n);
+#if !defined(THRUST_TBB_DISABLE_TEMPORARY_POOL)
+    ASSERT_EQUAL(true, first.first.get() == second.first.get());
+#endif
+    thrust::return_temporary_buffer(thrust::tbb::par, second.first, second.second);
+  }
+
+  thrust::tbb::release_temporary_storage();
+
+  // algorithms of different sizes share the pool
+  for(size_t n = (1 << 18) - 3; n < (1 << 19); n += (1 << 17) + 1)
+  {
+    thrust::host_vector<int> h_data = unittest::random_integers<int>(n);
+    thrust::host_vector<int> d_data = h_data;
+
+    thrust::stable_sort(h_data.begin(), h_data.end());
+    thrust::stable_sort(thrust::tbb::par.sequential_cutoff(0), d_data.begin(), d_data.end());
+
+    ASSERT_EQUAL(h_data, d_data);
+  }
+
+  thrust::tbb::release_temporary_storage();
+}
+DECLARE_UNITTEST(TestTbbParTemporaryStorageIsPooled);
+
+
+#if !defined(THRUST_TBB_DISABLE_TEMPORARY_POOL)
+void TestTbbReleaseTemporaryStorageOfEveryThread()
+{
+  typedef thrust::system::detail::internal::temporary_pool pool_type;
+
+  thrust::tbb::release_temporary_storage();
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  pool_type *worker_pool = nullptr;
+  bool done = false;
+
+  // the worker caches a buffer in its pool and waits until the pool has been checked
+  std::thread worker([&]
+  {
+    auto buffer = thrust::get_temporary_buffer<int>(thrust::tbb::par, 1 << 20);
+    thrust::return_temporary_buffer(thrust::tbb::par, buffer.first, buffer.second);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    worker_pool = &thrust::system::detail::internal::tls_temporary_pool();
+    cv.notify_all();
+    cv.wait(lock, [&] { return done; });
+  });
+
+  std::size_t cached_before = 0, cached_after = 0;
+
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [&] { return worker_pool != nullptr; });
+
+    cached_before = worker_pool->cached_bytes();
+    thrust::tbb::release_temporary_storage();
+    cached_after = worker_pool->cached_bytes();
+
+    done = true;
+    cv.notify_all();
+  }
+
+  worker.join();
+
+  ASSERT_EQUAL(cached_before, std::size_t(4) << 20);
+  ASSERT_EQUAL(cached_after, std::size_t(0));
+}
+DECLARE_UNITTEST(TestTbbReleaseTemporaryStorageOfEveryThread);
+
+void TestTbbTemporaryStorageCacheIsBounded()
+{
+  typedef thrust::system::detail::internal::temporary_pool pool_type;
+
+  thrust::tbb::release_temporary_storage();
+
+  pool_type &pool = thrust::system::detail::internal::tls_temporary_pool();
+
+  // one block more than the cap holds
+  const std::size_t max_cached_bytes = pool_type::max_cached_bytes;
+  const std::size_t num_blocks = 3;
+  const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(max_cached_bytes / 2 / sizeof(int));
+
+  std::vector<decltype(thrust::get_temporary_buffer<int>(thrust::tbb::par, n))> buffers;
+
+  for(std::size_t i = 0; i < num_blocks; ++i)
+  {
+    buffers.push_back(thrust::get_temporary_buffer<int>(thrust::tbb::par, n));
+  }
+
+  for(std::size_t i = 0; i < num_blocks; ++i)
+  {
+    thrust::return_temporary_buffer(thrust::tbb::par, buffers[i].first, buffers[i].second);
+  }
+
+  ASSERT_EQUAL(pool.cached_bytes(), max_cached_bytes);
+
+  thrust::tbb::release_temporary_storage();
+}
+DECLARE_UNITTEST(TestTbbTemporaryStorageCacheIsBounded);
+#endif
+
+
+void TestTbbParUninitializedFill()
+{
+  const size_t n = 100003;
+
+  thrust::tbb::vector<int> zeros(n);
+  ASSERT_EQUAL(0, thrust::reduce(zeros.begin(), zeros.end()));
+
+  thrust::tbb::vector<int> sevens(n, 7);
+  ASSERT_EQUAL(7 * static_cast<int>(n), thrust::reduce(sevens.begin(), sevens.end()));
+
+  // the requested partitioner replaces the static one
+  thrust::host_vector<unittest::int64_t> data(n);
+  thrust::uninitialized_fill(thrust::tbb::par.partitioner(thrust::tbb::partitioner_simple).grain_size(1000),
+                             data.begin(), data.end(), unittest::int64_t(13));
+  ASSERT_EQUAL(13 * static_cast<unittest::int64_t>(n), thrust::reduce(data.begin(), data.end()));
+}
+DECLARE_UNITTEST(TestTbbParUninitializedFill);
+
+
+// throws from the copy constructor once copies_left copies have been made, or never
+// when copies_left is negative
+struct throwing_copy
+{
+  static int copies_left;
+
+  int value;
+
+  throwing_copy() : value(0) {}
+
+  throwing_copy(int value) : value(value) {}
+
+  throwing_copy(const throwing_copy &other)
+    : value(other.value)
+  {
+    if(copies_left-- == 0)
+    {
+      throw std::runtime_error("throwing_copy");
+    }
+  }
+};
+
+int throwing_copy::copies_left = 0;
+
+void TestTbbParUninitializedFillThrowingCopy()
+{
+  const size_t n = 100003;
+
+  // the exception of the copy constructor reaches the caller
+  std::vector<throwing_copy> data(n);
+
+  throwing_copy::copies_left = static_cast<int>(n / 2);
+
+  bool caught = false;
+
+  try
+  {
+    thrust::uninitialized_fill(thrust::tbb::par.sequential_cutoff(0), data.begin(), data.end(), throwing_copy(13));
+  }
+  catch(const std::runtime_error &)
+  {
+    caught = true;
+  }
+
+  ASSERT_EQUAL(true, caught);
+
+  throwing_copy::copies_left = -1;
+
+  thrust::uninitialized_fill(thrust::tbb::par.sequential_cutoff(0), data.begin(), data.end(), throwing_copy(7));
+
+  bool filled = true;
+  for(size_t i = 0; i < n; ++i)
+  {
+    filled = filled && data[i].value == 7;
+  }
+
+  ASSERT_EQUAL(true, filled);
+}
+DECLARE_UNITTEST(TestTbbParUninitializedFillThrowingCopy);
@@ -0,0 +1,108 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/partition.h>
+#include <thrust/functional.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+struct counted_is_odd_length
+{
+  std::atomic<long> *calls;
+
+  bool operator()(const std::string &x) const
+  {
+    calls->fetch_add(1, std::memory_order_relaxed);
+    return x.size() % 2 == 1;
+  }
+};
+
+void TestTbbStablePartitionEvaluatesPredicateOnce()
+{
+  std::vector<std::string> input(10000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = std::to_string(i * 7919 % 100000);
+  }
+
+  std::vector<std::string> reference = input;
+  std::stable_partition(reference.begin(), reference.end(), [](const std::string &x) { return x.size() % 2 == 1; });
+
+  std::vector<int> stencil(input.size());
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    stencil[i] = input[i].size() % 2 == 1;
+  }
+
+  // the sequential path with one thread, and several threads otherwise
+  for(int threads = 1; threads <= 4; ++threads)
+  {
+    ::tbb::task_arena arena(threads);
+
+    const std::ptrdiff_t cutoff = threads == 1 ? static_cast<std::ptrdiff_t>(input.size()) + 1 : 0;
+
+    std::atomic<long> calls(0);
+    counted_is_odd_length pred = {&calls};
+
+    std::vector<std::string> partitioned = input;
+    thrust::stable_partition(thrust::tbb::par.arena(arena).sequential_cutoff(cutoff),
+                             partitioned.begin(), partitioned.end(), pred);
+
+    ASSERT_EQUAL(partitioned == reference, true);
+    ASSERT_EQUAL(calls.load(), static_cast<long>(input.size()));
+
+    std::vector<std::string> partitioned_by_stencil = input;
+    thrust::stable_partition(thrust::tbb::par.arena(arena).sequential_cutoff(cutoff),
+                             partitioned_by_stencil.begin(), partitioned_by_stencil.end(), stencil.begin(), thrust::identity<int>());
+
+    ASSERT_EQUAL(partitioned_by_stencil == reference, true);
+  }
+}
+DECLARE_UNITTEST(TestTbbStablePartitionEvaluatesPredicateOnce);
+
+template<typename T>
+struct is_odd
+{
+  bool operator()(T x) const
+  {
+    return (static_cast<unsigned int>(x) & 1) != 0;
+  }
+};
+
+template<typename T, typename Policy>
+void TestTbbParStablePartition(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_result = data, d_result = data;
+
+  thrust::stable_partition(h_result.begin(), h_result.end(), is_odd<T>());
+  thrust::stable_partition(policy, d_result.begin(), d_result.end(), is_odd<T>());
+  ASSERT_EQUAL(h_result, d_result);
+
+  // the stencil overload selects by the parity of the data, too
+  d_result = data;
+  thrust::stable_partition(policy, d_result.begin(), d_result.end(), data.begin(), is_odd<T>());
+  ASSERT_EQUAL(h_result, d_result);
+}
+
+template<typename T>
+struct TestTbbParStablePartitionPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParStablePartition<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParStablePartitionPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParStablePartitionPoliciesInstance;
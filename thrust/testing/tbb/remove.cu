@@ -0,0 +1,126 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/remove.h>
+#include <thrust/unique.h>
+#include <thrust/sequence.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+template<typename T>
+void TestTbbCompactInPlaceThreads(const std::vector<T> &input)
+{
+  // runs of equal elements, some of which straddle the tiles
+  auto is_odd_length = [](const T &x) { return x.size() % 2 == 1; };
+
+  std::vector<T> removed_reference = input;
+  removed_reference.erase(std::remove_if(removed_reference.begin(), removed_reference.end(), is_odd_length),
+                          removed_reference.end());
+
+  std::vector<T> unique_reference = input;
+  unique_reference.erase(std::unique(unique_reference.begin(), unique_reference.end()),
+                         unique_reference.end());
+
+  // one tile per thread of the arena; every tile but the first moves its elements down
+  for(int threads = 1; threads <= 5; ++threads)
+  {
+    ::tbb::task_arena arena(threads);
+
+    std::vector<T> removed = input;
+    removed.erase(thrust::remove_if(thrust::tbb::par.arena(arena).sequential_cutoff(0), removed.begin(), removed.end(), is_odd_length),
+                  removed.end());
+
+    std::vector<T> unique = input;
+    unique.erase(thrust::unique(thrust::tbb::par.arena(arena).sequential_cutoff(0), unique.begin(), unique.end()),
+                 unique.end());
+
+    // unique_by_key compacts a zip of the keys and the values in place
+    std::vector<T>   keys = input;
+    std::vector<int> values(input.size());
+    thrust::sequence(values.begin(), values.end());
+    keys.erase(thrust::unique_by_key(thrust::tbb::par.arena(arena).sequential_cutoff(0), keys.begin(), keys.end(), values.begin()).first,
+               keys.end());
+
+    ASSERT_EQUAL(removed.size(), removed_reference.size());
+    ASSERT_EQUAL(removed == removed_reference, true);
+    ASSERT_EQUAL(unique.size(), unique_reference.size());
+    ASSERT_EQUAL(unique == unique_reference, true);
+    ASSERT_EQUAL(keys == unique_reference, true);
+
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+      ASSERT_EQUAL(input[values[i]] == keys[i], true);
+      ASSERT_EQUAL(values[i] == 0 || !(input[values[i] - 1] == keys[i]), true);
+    }
+  }
+}
+
+void TestTbbCompactInPlaceNonTrivial()
+{
+  std::vector<std::string> input(10000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = std::to_string((i / 3) * 7919 % 1000);
+  }
+
+  TestTbbCompactInPlaceThreads(input);
+}
+DECLARE_UNITTEST(TestTbbCompactInPlaceNonTrivial);
+
+void TestTbbCompactInPlaceKeepAll()
+{
+  // no tile moves, and the scratch buffer is not allocated
+  std::vector<std::string> input(10000);
+  for(std::size_t i = 0; i < input.size(); ++i)
+  {
+    input[i] = std::to_string(2 * i) + "x";
+    if(input[i].size() % 2 == 1)
+    {
+      input[i] += "y";
+    }
+  }
+
+  TestTbbCompactInPlaceThreads(input);
+}
+DECLARE_UNITTEST(TestTbbCompactInPlaceKeepAll);
+
+template<typename T>
+struct is_odd
+{
+  bool operator()(T x) const
+  {
+    return (static_cast<unsigned int>(x) & 1) != 0;
+  }
+};
+
+template<typename T, typename Policy>
+void TestTbbParRemoveIf(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_result = data, d_result = data;
+
+  h_result.erase(thrust::remove_if(h_result.begin(), h_result.end(), is_odd<T>()), h_result.end());
+  d_result.erase(thrust::remove_if(policy, d_result.begin(), d_result.end(), is_odd<T>()), d_result.end());
+  ASSERT_EQUAL(h_result, d_result);
+}
+
+template<typename T>
+struct TestTbbParRemoveIfPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParRemoveIf<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParRemoveIfPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParRemoveIfPoliciesInstance;
@@ -0,0 +1,32 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/scan.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestTbbParInclusiveScan(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> h_result(n), d_result(n);
+
+  thrust::inclusive_scan(data.begin(), data.end(), h_result.begin());
+  thrust::inclusive_scan(policy, data.begin(), data.end(), d_result.begin());
+  ASSERT_EQUAL(h_result, d_result);
+}
+
+template<typename T>
+struct TestTbbParInclusiveScanPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParInclusiveScan<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParInclusiveScanPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParInclusiveScanPoliciesInstance;
@@ -0,0 +1,31 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/sequence.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestTbbParSequence(Policy policy, size_t n)
+{
+  thrust::host_vector<T> h_data(n), d_data(n);
+
+  thrust::sequence(h_data.begin(), h_data.end());
+  thrust::sequence(policy, d_data.begin(), d_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+}
+
+template<typename T>
+struct TestTbbParSequencePolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParSequence<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParSequencePolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParSequencePoliciesInstance;
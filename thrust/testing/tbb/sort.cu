@@ -0,0 +1,259 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/functional.h>
+#include <thrust/sort.h>
+#include <thrust/system/detail/internal/index_sort.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+void TestTbbSortNumLeaves()
+{
+  namespace sort_detail = thrust::system::tbb::detail::sort_detail;
+
+  const std::size_t leaf_bytes = sort_detail::leaf_bytes();
+
+  // element sizes which give leaves of many elements, of two elements and of one element
+  const std::size_t element_sizes[] = {sizeof(int), leaf_bytes / 2, leaf_bytes + 1, 4 * leaf_bytes};
+
+  for(std::size_t s = 0; s < sizeof(element_sizes) / sizeof(element_sizes[0]); ++s)
+  {
+    for(long n = 0; n < 1000; ++n)
+    {
+      const long leaves = sort_detail::num_leaves(n, element_sizes[s]);
+
+      // a power of two of non-empty leaves
+      ASSERT_EQUAL(leaves > 0, true);
+      ASSERT_EQUAL(leaves & (leaves - 1), 0);
+      ASSERT_EQUAL(leaves <= std::max(n, 1l), true);
+    }
+  }
+}
+DECLARE_UNITTEST(TestTbbSortNumLeaves);
+
+void TestTbbStableSortNonTrivialKeys()
+{
+  // several leaves, so that some are sorted in the buffer and merged
+  const std::size_t n = 100000;
+
+  std::vector<std::string> keys(n);
+  std::vector<std::size_t> values(n);
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    keys[i]   = std::to_string((i * 7919) % 1000);
+    values[i] = i;
+  }
+
+  std::vector<std::pair<std::string, std::size_t> > reference(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    reference[i] = std::make_pair(keys[i], values[i]);
+  }
+  std::stable_sort(reference.begin(), reference.end(),
+                   [](const std::pair<std::string, std::size_t> &a, const std::pair<std::string, std::size_t> &b) { return a.first < b.first; });
+
+  std::vector<std::string> sorted = keys;
+  thrust::stable_sort(thrust::tbb::par.sequential_cutoff(0), sorted.begin(), sorted.end());
+
+  thrust::stable_sort_by_key(thrust::tbb::par.sequential_cutoff(0), keys.begin(), keys.end(), values.begin());
+
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    ASSERT_EQUAL(sorted[i] == reference[i].first, true);
+    ASSERT_EQUAL(keys[i] == reference[i].first, true);
+    ASSERT_EQUAL(values[i], reference[i].second);
+  }
+}
+DECLARE_UNITTEST(TestTbbStableSortNonTrivialKeys);
+
+template<typename T, typename Policy>
+void TestTbbParStableSort(Policy policy, size_t n)
+{
+  thrust::host_vector<T> h_data = unittest::random_integers<T>(n);
+  thrust::host_vector<T> d_data = h_data;
+
+  thrust::stable_sort(h_data.begin(), h_data.end());
+  thrust::stable_sort(policy, d_data.begin(), d_data.end());
+  ASSERT_EQUAL(h_data, d_data);
+}
+
+template<typename T>
+struct TestTbbParStableSortPolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParStableSort<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParStableSortPolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParStableSortPoliciesInstance;
+
+template<typename T>
+struct less_than
+{
+  bool operator()(T x, T y) const
+  {
+    return x < y;
+  }
+};
+
+template<typename T, typename Value>
+void TestTbbParSortByKeyValues(const size_t n)
+{
+  // few distinct keys, so that the order of equal keys is checked
+  thrust::host_vector<T> keys = unittest::random_integers<T>(n);
+  thrust::host_vector<Value> values(n);
+
+  for(size_t i = 0; i < n; ++i)
+  {
+    keys[i] = keys[i] % 64;
+    values[i] = Value(static_cast<T>(i));
+  }
+
+  thrust::host_vector<T> h_keys = keys, d_keys = keys;
+  thrust::host_vector<Value> h_values = values, d_values = values;
+
+  thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin());
+  thrust::stable_sort_by_key(thrust::tbb::par.sequential_cutoff(0), d_keys.begin(), d_keys.end(), d_values.begin());
+
+  ASSERT_EQUAL(h_keys, d_keys);
+  ASSERT_EQUAL_QUIET(h_values, d_values);
+
+  // the merge sort takes the comparisons the radix sort does not
+  h_keys = d_keys = keys;
+  h_values = d_values = values;
+
+  thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin(), less_than<T>());
+  thrust::stable_sort_by_key(thrust::tbb::par.sequential_cutoff(0), d_keys.begin(), d_keys.end(), d_values.begin(), less_than<T>());
+
+  ASSERT_EQUAL(h_keys, d_keys);
+  ASSERT_EQUAL_QUIET(h_values, d_values);
+}
+
+template<typename T>
+struct TestTbbParSortByKeyLargeValues
+{
+  void operator()(const size_t n)
+  {
+    using thrust::system::detail::internal::index_sort_value_size;
+    using thrust::system::detail::internal::use_index_sort;
+
+    // the largest values carried through the sort, and the smallest which follow their keys by index
+    typedef FixedVector<T, index_sort_value_size / sizeof(T)>     carried_value;
+    typedef FixedVector<T, index_sort_value_size / sizeof(T) + 1> indexed_value;
+
+    ASSERT_EQUAL(false, use_index_sort<carried_value>::value);
+    ASSERT_EQUAL(true,  use_index_sort<indexed_value>::value);
+
+    TestTbbParSortByKeyValues<T, carried_value>(n);
+    TestTbbParSortByKeyValues<T, indexed_value>(n);
+  }
+};
+VariableUnitTest<TestTbbParSortByKeyLargeValues, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParSortByKeyLargeValuesInstance;
+
+template<typename T>
+struct TestTbbParStableSortAffinity
+{
+  void operator()(const size_t n)
+  {
+    thrust::host_vector<T> keys = unittest::random_integers<T>(n);
+    thrust::host_vector<T> values(n);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      keys[i]   = keys[i] % 1024;
+      values[i] = static_cast<T>(i);
+    }
+
+    thrust::host_vector<T> h_keys = keys, h_values = values;
+    thrust::stable_sort_by_key(h_keys.begin(), h_keys.end(), h_values.begin());
+
+    // workers for the arena even where there are fewer cores
+    ::tbb::global_control parallelism(::tbb::global_control::max_allowed_parallelism, 4);
+    ::tbb::task_arena arena(4);
+    thrust::tbb::affinity_handle affinity;
+
+    // the comparator takes the merge sort, whose merges run within the loop over its leaves
+    for(int i = 0; i < 3; ++i)
+    {
+      thrust::host_vector<T> d_keys = keys, d_values = values;
+      thrust::stable_sort(thrust::tbb::par.arena(arena).affinity(affinity).sequential_cutoff(0), d_keys.begin(), d_keys.end(), less_than<T>());
+      ASSERT_EQUAL(h_keys, d_keys);
+
+      d_keys = keys;
+      thrust::stable_sort_by_key(thrust::tbb::par.arena(arena).affinity(affinity).sequential_cutoff(0), d_keys.begin(), d_keys.end(), d_values.begin(), less_than<T>());
+      ASSERT_EQUAL(h_keys, d_keys);
+      ASSERT_EQUAL(h_values, d_values);
+    }
+  }
+};
+VariableUnitTest<TestTbbParStableSortAffinity, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParStableSortAffinityInstance;
+
+template<typename Key, typename Compare>
+void TestTbbRadixSortLargeKeys(Compare comp)
+{
+  // above the size from which the radix sort runs in parallel
+  const std::size_t n = (1 << 16) + 5;
+
+  thrust::host_vector<unittest::int64_t> random = unittest::random_integers<unittest::int64_t>(n);
+
+  // both signs, and for the narrow keys, many equal keys whose order is checked
+  std::vector<std::pair<Key, std::size_t> > reference(n);
+  thrust::host_vector<Key> input(n);
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    input[i]     = static_cast<Key>(random[i] % 100000) / static_cast<Key>(4);
+    reference[i] = std::make_pair(input[i], i);
+  }
+  std::stable_sort(reference.begin(), reference.end(),
+                   [comp](const std::pair<Key, std::size_t> &a, const std::pair<Key, std::size_t> &b) { return comp(a.first, b.first); });
+
+  for(int threads = 1; threads <= 4; ++threads)
+  {
+    ::tbb::task_arena arena(threads);
+
+    thrust::host_vector<Key> sorted = input;
+    thrust::stable_sort(thrust::tbb::par.arena(arena).sequential_cutoff(0), sorted.begin(), sorted.end(), comp);
+
+    thrust::host_vector<Key>         keys = input;
+    thrust::host_vector<std::size_t> values(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      values[i] = i;
+    }
+    thrust::stable_sort_by_key(thrust::tbb::par.arena(arena).sequential_cutoff(0), keys.begin(), keys.end(), values.begin(), comp);
+
+    bool matches = true;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      matches = matches && sorted[i] == reference[i].first && keys[i] == reference[i].first && values[i] == reference[i].second;
+    }
+
+    ASSERT_EQUAL(true, matches);
+  }
+}
+
+void TestTbbRadixSortLarge()
+{
+  TestTbbRadixSortLargeKeys<signed char>(thrust::less<signed char>());
+  TestTbbRadixSortLargeKeys<short>(thrust::greater<short>());
+  TestTbbRadixSortLargeKeys<unittest::int32_t>(thrust::less<unittest::int32_t>());
+  TestTbbRadixSortLargeKeys<unittest::uint32_t>(thrust::greater<unittest::uint32_t>());
+  TestTbbRadixSortLargeKeys<unittest::int64_t>(thrust::greater<unittest::int64_t>());
+  TestTbbRadixSortLargeKeys<float>(thrust::less<float>());
+  TestTbbRadixSortLargeKeys<double>(thrust::greater<double>());
+}
+DECLARE_UNITTEST(TestTbbRadixSortLarge);
@@ -0,0 +1,31 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/functional.h>
+#include <thrust/transform_reduce.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestTbbParTransformReduce(Policy policy, size_t n)
+{
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+
+  ASSERT_EQUAL(thrust::transform_reduce(policy, data.begin(), data.end(), thrust::negate<T>(), T(0), thrust::plus<T>()),
+               thrust::transform_reduce(data.begin(), data.end(), thrust::negate<T>(), T(0), thrust::plus<T>()));
+}
+
+template<typename T>
+struct TestTbbParTransformReducePolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParTransformReduce<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParTransformReducePolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParTransformReducePoliciesInstance;
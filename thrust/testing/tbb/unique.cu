@@ -0,0 +1,40 @@
+#include <unittest/unittest.h>
+#include <unittest/parallel_policies.h>
+
+#include <thrust/sort.h>
+#include <thrust/unique.h>
+#include <thrust/system/tbb/execution_policy.h>
+
+template<typename T, typename Policy>
+void TestTbbParUnique(Policy policy, size_t n)
+{
+  // few distinct values, so that the runs of equal elements straddle the tiles
+  thrust::host_vector<T> data = unittest::random_integers<T>(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    data[i] = static_cast<T>(data[i] % 1024);
+  }
+  thrust::sort(data.begin(), data.end());
+
+  thrust::host_vector<T> h_result = data, d_result = data;
+
+  h_result.erase(thrust::unique(h_result.begin(), h_result.end()), h_result.end());
+  d_result.erase(thrust::unique(policy, d_result.begin(), d_result.end()), d_result.end());
+  ASSERT_EQUAL(h_result, d_result);
+}
+
+template<typename T>
+struct TestTbbParUniquePolicies
+{
+  template<typename Policy>
+  void operator()(Policy policy, size_t n) const
+  {
+    TestTbbParUnique<T>(policy, n);
+  }
+
+  void operator()() const
+  {
+    unittest::check_parallel_policies(*this);
+  }
+};
+SimpleUnitTest<TestTbbParUniquePolicies, unittest::type_list<unittest::int32_t,unittest::uint64_t> > TestTbbParUniquePoliciesInstance;
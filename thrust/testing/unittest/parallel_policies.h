@@ -0,0 +1,75 @@
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+#include <thrust/system/omp/execution_policy.h>
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+#include <thrust/system/tbb/execution_policy.h>
+
+#include <tbb/task_arena.h>
+#endif
+
+#include <cstddef>
+#include <memory>
+
+namespace unittest
+{
+
+#if THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_OMP
+
+// calls check(policy, n) with policies built from thrust::omp::par which request a number of
+// threads, a schedule, an allocator and a sequential cutoff. the sizes are above the default
+// cutoff, so that only the policy with a cutoff of n + 1 runs sequentially
+template<typename Check>
+void check_parallel_policies(const Check &check)
+{
+  const size_t sizes[] = {THRUST_OMP_SEQUENTIAL_CUTOFF + 1, 100003};
+
+  for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    const size_t n = sizes[i];
+
+    check(thrust::omp::par.num_threads(2), n);
+    check(thrust::omp::par.num_threads(5).schedule(thrust::omp::schedule_dynamic, 16), n);
+    check(thrust::omp::par.schedule(thrust::omp::schedule_guided), n);
+    check(thrust::omp::par(std::allocator<int>()).num_threads(3), n);
+    check(thrust::omp::par.num_threads(4).sequential_cutoff(0), n);
+    check(thrust::omp::par.sequential_cutoff(n + 1), n);
+  }
+}
+
+#elif THRUST_DEVICE_SYSTEM == THRUST_DEVICE_SYSTEM_TBB
+
+// calls check(policy, n) with policies built from thrust::tbb::par which request an arena, a
+// partitioner, a grain size, an affinity handle, an allocator and a sequential cutoff. the sizes
+// are above the default cutoff, so that only the policy with a cutoff of n + 1 runs sequentially
+template<typename Check>
+void check_parallel_policies(const Check &check)
+{
+  ::tbb::task_arena arena(3);
+  thrust::tbb::affinity_handle affinity;
+
+  const size_t sizes[] = {THRUST_TBB_SEQUENTIAL_CUTOFF + 1, 100003};
+
+  for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+  {
+    const size_t n = sizes[i];
+
+    check(thrust::tbb::par, n);
+    check(thrust::tbb::par.sequential_cutoff(0), n);
+    check(thrust::tbb::par.sequential_cutoff(n + 1), n);
+    check(thrust::tbb::par(std::allocator<int>()).sequential_cutoff(0), n);
+    check(thrust::tbb::par.arena(arena).sequential_cutoff(0), n);
+    check(thrust::tbb::par.partitioner(thrust::tbb::partitioner_simple).grain_size(1), n);
+    check(thrust::tbb::par.partitioner(thrust::tbb::partitioner_static), n);
+    check(thrust::tbb::par.partitioner(thrust::tbb::partitioner_affinity).grain_size(512), n);
+    check(thrust::tbb::par(std::allocator<int>()).arena(arena).grain_size(64), n);
+    check(thrust::tbb::par.affinity(affinity), n);
+    check(thrust::tbb::par.arena(arena).affinity(affinity).sequential_cutoff(0), n);
+  }
+}
+
+#endif
+
+} // end unittest
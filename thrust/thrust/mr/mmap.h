@@ -0,0 +1,310 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file
+ *  \brief \p mmap-based memory resource, backed by huge pages and placed on NUMA nodes on request. Linux only.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#if defined(__linux__)
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/mr/memory_resource.h>
+#include <thrust/mr/allocator.h>
+#include <thrust/system/detail/bad_alloc.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/** \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! The kind of pages backing the memory of an \p mmap_resource.
+ */
+enum mmap_huge_pages
+{
+    /*! Regular pages. */
+    mmap_no_huge_pages,
+    /*! Regular pages, aligned to and advised with \p MADV_HUGEPAGE, so that the kernel may back them with transparent huge
+     *      pages.
+     */
+    mmap_transparent_huge_pages,
+    /*! Huge pages of \p mmap_options::huge_page_size from the reserved pool of the kernel, with \p MAP_HUGETLB. Falls back
+     *      to transparent huge pages when the pool cannot satisfy an allocation.
+     */
+    mmap_explicit_huge_pages
+};
+
+/*! The NUMA placement of the memory of an \p mmap_resource.
+ */
+enum mmap_numa_placement
+{
+    /*! Each page is placed on the node of the thread which first touches it, which is the default policy of the kernel.
+     *      Initializing the memory in parallel, with the threads which later use it, keeps their accesses local.
+     */
+    mmap_first_touch,
+    /*! The pages are interleaved round-robin across the nodes of \p mmap_options::node_mask, which balances the bandwidth
+     *      of memory shared by all nodes.
+     */
+    mmap_interleave
+};
+
+/*! A type used for configuring \p mmap_resource.
+ */
+struct mmap_options
+{
+    /*! The kind of pages backing allocations. */
+    mmap_huge_pages huge_pages;
+    /*! The NUMA placement of allocations. */
+    mmap_numa_placement placement;
+    /*! The nodes across which \p mmap_interleave places pages; bit \p i selects node \p i. */
+    unsigned long node_mask;
+    /*! The size of a huge page; 2MB on most systems. A power of two, which \p mmap_explicit_huge_pages requests from the
+     *      pool of that size, and which falls back to transparent huge pages when the kernel has no such pool.
+     */
+    std::size_t huge_page_size;
+
+    /*! Checks if the options are self-consistent.
+     *
+     *  /returns true if the options are self-consitent, false otherwise.
+     */
+    bool validate() const
+    {
+        if (!detail::is_power_of_2(huge_page_size)) return false;
+
+        return true;
+    }
+};
+
+/*! A memory resource which maps memory directly from the kernel with \p mmap, and returns it with \p munmap. Intended for
+ *      large, long-lived allocations, such as the storage of huge vectors, whose TLB misses and remote accesses are reduced
+ *      by huge pages and NUMA placement; small allocations should go through a pool, such as
+ *      \p unsynchronized_pool_resource, of which it may be the upstream.
+ *
+ *  Deallocation must be given the size and alignment which were passed to allocation.
+ */
+class mmap_resource final : public memory_resource<>
+{
+public:
+    /*! Transparent huge pages, placed by first touch. */
+    static mmap_options get_default_options()
+    {
+        mmap_options ret;
+
+        ret.huge_pages = mmap_transparent_huge_pages;
+        ret.placement = mmap_first_touch;
+        ret.node_mask = ~0ul;
+        ret.huge_page_size = 2 * 1024 * 1024;
+
+        return ret;
+    }
+
+    /*! Constructor.
+     *
+     *  \param options the options of the resource
+     */
+    mmap_resource(mmap_options options = get_default_options())
+        : m_options(options)
+    {
+        assert(m_options.validate());
+    }
+
+    /*! Returns the options of the resource. */
+    const mmap_options & get_options() const
+    {
+        return m_options;
+    }
+
+    void * do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        void * p = MAP_FAILED;
+
+        if (m_options.huge_pages == mmap_explicit_huge_pages && alignment <= m_options.huge_page_size)
+        {
+            // the length of a MAP_HUGETLB mapping is a multiple of the huge page size, which aligns its address
+            p = ::mmap(NULL, mapped_size(bytes, alignment), PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | huge_page_flags(), -1, 0);
+        }
+
+        if (p == MAP_FAILED)
+        {
+            p = map_aligned(mapped_size(bytes, alignment), mapping_alignment(alignment));
+        }
+
+        if (m_options.placement == mmap_interleave)
+        {
+            interleave(p, mapped_size(bytes, alignment));
+        }
+
+        return p;
+    }
+
+    void do_deallocate(void * p, std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        ::munmap(p, mapped_size(bytes, alignment));
+    }
+
+    /*! Two \p mmap_resource objects compare equal when memory allocated by one may be deallocated by the other. */
+    bool do_is_equal(const memory_resource & other) const noexcept override
+    {
+        const mmap_resource * mmap_other = dynamic_cast<const mmap_resource *>(&other);
+        return mmap_other && mmap_other->granularity() == granularity();
+    }
+
+private:
+    mmap_options m_options;
+
+    static std::size_t page_size()
+    {
+        static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    static std::size_t round_up(std::size_t n, std::size_t multiple)
+    {
+        return (n + multiple - 1) / multiple * multiple;
+    }
+
+    // MAP_HUGETLB, with the size of the huge pages encoded as its log2 above MAP_HUGE_SHIFT; without a
+    // size, the kernel would map pages of its default size, which need not be the size mappings are
+    // rounded to
+    int huge_page_flags() const
+    {
+#if defined(MAP_HUGE_SHIFT)
+        const int huge_shift = MAP_HUGE_SHIFT;
+#else
+        // of <linux/mman.h>, which older C libraries do not expose
+        const int huge_shift = 26;
+#endif
+
+        return MAP_HUGETLB | (static_cast<int>(detail::log2(m_options.huge_page_size)) << huge_shift);
+    }
+
+    // the huge page size to which mappings are rounded, or zero; all that deallocation needs to recompute their length
+    std::size_t granularity() const
+    {
+        return m_options.huge_pages == mmap_no_huge_pages ? 0 : m_options.huge_page_size;
+    }
+
+    std::size_t mapped_size(std::size_t bytes, std::size_t alignment) const
+    {
+        if (bytes == 0)
+        {
+            bytes = 1;
+        }
+
+        // mappings which may be backed by huge pages span whole huge pages
+        if (granularity() != 0 && alignment <= m_options.huge_page_size)
+        {
+            return round_up(bytes, m_options.huge_page_size);
+        }
+
+        return round_up(bytes, page_size());
+    }
+
+    std::size_t mapping_alignment(std::size_t alignment) const
+    {
+        if (granularity() != 0 && alignment < m_options.huge_page_size)
+        {
+            alignment = m_options.huge_page_size;
+        }
+
+        return alignment < page_size() ? page_size() : alignment;
+    }
+
+    // maps size bytes at a multiple of alignment, by mapping alignment bytes more and
+    // returning the excess on both sides
+    void * map_aligned(std::size_t size, std::size_t alignment) const
+    {
+        const std::size_t excess = alignment > page_size() ? alignment : 0;
+
+        void * mapped = ::mmap(NULL, size + excess, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (mapped == MAP_FAILED)
+        {
+            throw thrust::system::detail::bad_alloc("mmap_resource::do_allocate: mmap failed");
+        }
+
+        char * first = static_cast<char *>(mapped);
+        char * aligned = reinterpret_cast<char *>(round_up(reinterpret_cast<std::uintptr_t>(first), alignment));
+
+        if (aligned != first)
+        {
+            ::munmap(first, aligned - first);
+        }
+
+        if (static_cast<std::size_t>(aligned - first) < excess)
+        {
+            ::munmap(aligned + size, excess - (aligned - first));
+        }
+
+        if (m_options.huge_pages != mmap_no_huge_pages)
+        {
+            ::madvise(aligned, size, MADV_HUGEPAGE);
+        }
+
+        return aligned;
+    }
+
+    // the policy is a hint: on kernels without NUMA support, pages are placed by first touch
+    void interleave(void * p, std::size_t size) const
+    {
+        // MPOL_INTERLEAVE of <linux/mempolicy.h>
+        const int mpol_interleave = 3;
+
+        unsigned long node_mask = m_options.node_mask;
+
+        ::syscall(SYS_mbind, p, size, mpol_interleave, &node_mask, sizeof(node_mask) * 8, 0u);
+    }
+};
+
+/*! An allocator of memory mapped by a global \p mmap_resource with its default options, such as
+ *      <tt>thrust::host_vector<T, thrust::mr::mmap_allocator<T> ></tt>. An \p mmap_resource with other options is used through
+ *      <tt>thrust::mr::allocator<T, thrust::mr::mmap_resource></tt>.
+ */
+template<typename T>
+using mmap_allocator = thrust::mr::stateless_resource_allocator<T, mmap_resource>;
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // __linux__
+
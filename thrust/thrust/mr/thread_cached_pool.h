@@ -0,0 +1,378 @@
+/*
+ *  Copyright 2018 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thread_cached_pool.h
+ *  \brief A synchronized version of \p unsynchronized_pool_resource, which caches blocks per thread.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <thrust/mr/pool.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace mr
+{
+
+/*! \addtogroup memory_resources Memory Resources
+ *  \ingroup memory_management
+ *  \{
+ */
+
+/*! A synchronized version of \p unsynchronized_pool_resource, which scales to many concurrent threads. Each thread keeps
+ *      a magazine of free blocks for every block size of the pool, and only takes the lock of the shared, central pool
+ *      to refill an empty magazine or to drain a full one, by half of its capacity at a time. Blocks may be deallocated by
+ *      any thread. Oversized and overaligned blocks are allocated and deallocated directly by the central pool. Uses
+ *      \p std::mutex and \p thread_local, and therefore requires C++11.
+ *
+ *  The blocks in the magazine of a thread return to the central pool when the thread exits. The destructor returns every
+ *      block to upstream, including those still cached by threads, so a thread which exits after the resource is destroyed
+ *      discards its magazines without touching the pool or upstream. \p release and the destructor must not run
+ *      concurrently with allocations or deallocations of other threads.
+ *
+ *  \tparam Upstream the type of memory resources that will be used for allocating memory
+ */
+template<typename Upstream>
+class thread_cached_pool_resource final : public memory_resource<typename Upstream::pointer>
+{
+    typedef unsynchronized_pool_resource<Upstream> unsync_pool;
+    typedef std::lock_guard<std::mutex> lock_t;
+
+    typedef typename Upstream::pointer void_ptr;
+
+public:
+    /*! The number of blocks of each size cached by a thread, unless the constructor is given another number.
+     */
+    static const std::size_t default_magazine_size = 64;
+
+    /*! Get the default options for a pool. These are meant to be a sensible set of values for many use cases,
+     *      and as such, may be tuned in the future. This function is exposed so that creating a set of options that are
+     *      just a slight departure from the defaults is easy.
+     */
+    static pool_options get_default_options()
+    {
+        return unsync_pool::get_default_options();
+    }
+
+    /*! Constructor.
+     *
+     *  \param upstream the upstream memory resource for allocations
+     *  \param options pool options to use
+     *  \param magazine_size the number of blocks of each size cached by a thread
+     */
+    thread_cached_pool_resource(Upstream * upstream, pool_options options = get_default_options(),
+        std::size_t magazine_size = default_magazine_size)
+        : m_central(std::make_shared<central_pool>(upstream, options)),
+        m_options(options),
+        m_smallest_block_log2(detail::log2_ri(options.smallest_block_size)),
+        m_magazine_size(magazine_size < 2 ? 2 : magazine_size),
+        m_id(next_id())
+    {
+    }
+
+    /*! Constructor. The upstream resource is obtained by calling \p get_global_resource<Upstream>.
+     *
+     *  \param options pool options to use
+     *  \param magazine_size the number of blocks of each size cached by a thread
+     */
+    thread_cached_pool_resource(pool_options options = get_default_options(),
+        std::size_t magazine_size = default_magazine_size)
+        : thread_cached_pool_resource(get_global_resource<Upstream>(), options, magazine_size)
+    {
+    }
+
+    /*! Destructor. Releases all held memory to upstream, including the blocks cached by every thread.
+     */
+    ~thread_cached_pool_resource()
+    {
+        lock_t lock(m_central->mtx);
+        m_central->pool.release();
+
+        // a thread exiting later may still hold the central pool, but must not return its magazines to it
+        m_central->live = false;
+    }
+
+    /*! Releases all held memory to upstream, including the blocks cached by every thread.
+     */
+    void release()
+    {
+        lock_t lock(m_central->mtx);
+        m_central->pool.release();
+
+        // the magazines filled before are discarded by their threads
+        m_central->epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    THRUST_NODISCARD virtual void_ptr do_allocate(std::size_t bytes, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        if (is_oversized(bytes, alignment))
+        {
+            lock_t lock(m_central->mtx);
+            return m_central->pool.do_allocate(bytes, alignment);
+        }
+
+        const std::size_t size_class = get_size_class(bytes);
+        std::vector<void_ptr> & magazine = local_cache().magazines[size_class];
+
+        if (magazine.empty())
+        {
+            refill(magazine, size_class);
+        }
+
+        void_ptr ret = magazine.back();
+        magazine.pop_back();
+
+        return ret;
+    }
+
+    virtual void do_deallocate(void_ptr p, std::size_t n, std::size_t alignment = THRUST_MR_DEFAULT_ALIGNMENT) override
+    {
+        if (is_oversized(n, alignment))
+        {
+            lock_t lock(m_central->mtx);
+            m_central->pool.do_deallocate(p, n, alignment);
+            return;
+        }
+
+        const std::size_t size_class = get_size_class(n);
+        std::vector<void_ptr> & magazine = local_cache().magazines[size_class];
+
+        magazine.push_back(p);
+
+        if (magazine.size() > m_magazine_size)
+        {
+            drain(magazine, size_class);
+        }
+    }
+
+private:
+    struct central_pool
+    {
+        central_pool(Upstream * upstream, pool_options options)
+            : pool(upstream, options), epoch(0), live(true)
+        {
+        }
+
+        std::mutex mtx;
+        unsync_pool pool;
+        std::atomic<std::size_t> epoch;
+
+        // cleared under mtx by the destructor of the resource, once pool has returned its memory to upstream,
+        // which may be destroyed right after the resource
+        bool live;
+    };
+
+    // the magazines of one thread for one resource; the central pool outlives its
+    // resource while a thread returns its magazines to it, but no longer holds
+    // memory once the resource is destroyed
+    struct thread_cache
+    {
+        std::weak_ptr<central_pool> central;
+        std::size_t epoch;
+        std::size_t smallest_block_log2;
+        std::size_t alignment;
+        std::vector<std::vector<void_ptr> > magazines;
+
+        void flush()
+        {
+            std::shared_ptr<central_pool> locked = central.lock();
+
+            if (!locked)
+            {
+                return;
+            }
+
+            lock_t lock(locked->mtx);
+
+            if (!locked->live || locked->epoch.load(std::memory_order_acquire) != epoch)
+            {
+                return;
+            }
+
+            for (std::size_t i = 0; i < magazines.size(); ++i)
+            {
+                for (std::size_t j = 0; j < magazines[i].size(); ++j)
+                {
+                    locked->pool.do_deallocate(magazines[i][j], std::size_t(1) << (smallest_block_log2 + i), alignment);
+                }
+
+                magazines[i].clear();
+            }
+        }
+    };
+
+    // the caches of one thread, keyed by the ids of their resources
+    struct cache_registry
+    {
+        cache_registry() : last_id(0), last(NULL)
+        {
+        }
+
+        std::unordered_map<std::size_t, thread_cache> caches;
+
+        // the cache used most recently, which skips the lookup while a thread works with one resource
+        std::size_t last_id;
+        thread_cache * last;
+
+        ~cache_registry()
+        {
+            for (typename std::unordered_map<std::size_t, thread_cache>::iterator it = caches.begin(); it != caches.end(); ++it)
+            {
+                it->second.flush();
+            }
+        }
+    };
+
+    std::shared_ptr<central_pool> m_central;
+    pool_options m_options;
+    std::size_t m_smallest_block_log2;
+    std::size_t m_magazine_size;
+
+    // ids are never reused, unlike the addresses of resources
+    std::size_t m_id;
+
+    static std::size_t next_id()
+    {
+        static std::atomic<std::size_t> counter(0);
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool is_oversized(std::size_t bytes, std::size_t alignment) const
+    {
+        return bytes > m_options.largest_block_size || alignment > m_options.alignment;
+    }
+
+    std::size_t get_size_class(std::size_t bytes) const
+    {
+        bytes = (std::max)(bytes, m_options.smallest_block_size);
+        return detail::log2_ri(bytes) - m_smallest_block_log2;
+    }
+
+    std::size_t block_size(std::size_t size_class) const
+    {
+        return std::size_t(1) << (m_smallest_block_log2 + size_class);
+    }
+
+    thread_cache & local_cache()
+    {
+        static thread_local cache_registry registry;
+
+        if (!registry.last || registry.last_id != m_id)
+        {
+            registry.last = &lookup(registry);
+            registry.last_id = m_id;
+        }
+
+        thread_cache & cache = *registry.last;
+
+        // the blocks of the magazines were returned to upstream by release()
+        const std::size_t epoch = m_central->epoch.load(std::memory_order_relaxed);
+
+        if (cache.epoch != epoch)
+        {
+            for (std::size_t i = 0; i < cache.magazines.size(); ++i)
+            {
+                cache.magazines[i].clear();
+            }
+
+            cache.epoch = epoch;
+        }
+
+        return cache;
+    }
+
+    thread_cache & lookup(cache_registry & registry)
+    {
+        typename std::unordered_map<std::size_t, thread_cache>::iterator it = registry.caches.find(m_id);
+
+        if (it == registry.caches.end())
+        {
+            // forget the caches of destroyed resources
+            for (it = registry.caches.begin(); it != registry.caches.end();)
+            {
+                if (it->second.central.expired())
+                {
+                    it = registry.caches.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            thread_cache cache;
+            cache.central = m_central;
+            cache.epoch = m_central->epoch.load(std::memory_order_acquire);
+            cache.smallest_block_log2 = m_smallest_block_log2;
+            cache.alignment = m_options.alignment;
+            cache.magazines.resize(detail::log2_ri(m_options.largest_block_size) - m_smallest_block_log2 + 1);
+
+            it = registry.caches.emplace(m_id, std::move(cache)).first;
+        }
+
+        return it->second;
+    }
+
+    void refill(std::vector<void_ptr> & magazine, std::size_t size_class)
+    {
+        lock_t lock(m_central->mtx);
+
+        for (std::size_t i = 0; i < m_magazine_size / 2; ++i)
+        {
+            magazine.push_back(m_central->pool.do_allocate(block_size(size_class), m_options.alignment));
+        }
+    }
+
+    void drain(std::vector<void_ptr> & magazine, std::size_t size_class)
+    {
+        lock_t lock(m_central->mtx);
+
+        while (magazine.size() > m_magazine_size / 2)
+        {
+            m_central->pool.do_deallocate(magazine.back(), block_size(size_class), m_options.alignment);
+            magazine.pop_back();
+        }
+    }
+};
+
+/*! \} // memory_resources
+ */
+
+} // end mr
+THRUST_NAMESPACE_END
+
+#endif // _CCCL_STD_VER >= 2011
+
@@ -0,0 +1,64 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file adjacent_difference.h
+ *  \brief The tile kernel of adjacent_difference shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/raw_reference_cast.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// writes binary_op(first[i], first[i - 1]) to result[i] for every i in (begin, end)
+// the loop runs backwards, so result may equal first: each element is read before its
+// position in result is written. first[begin] is left intact, and the caller writes
+// result[begin] afterwards from the element preceding the tile, which it must have
+// read before any tile was written
+template<typename RandomAccessIterator, typename OutputIterator, typename Size, typename BinaryFunction>
+void adjacent_difference_tile(RandomAccessIterator first, Size begin, Size end, OutputIterator result, BinaryFunction binary_op)
+{
+  for(Size i = end - 1; i > begin; --i)
+  {
+    OutputIterator out = result + i;
+    *out = binary_op(thrust::raw_reference_cast(first[i]), thrust::raw_reference_cast(first[i - 1]));
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
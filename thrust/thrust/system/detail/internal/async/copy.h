@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp14_required.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <thrust/copy.h>
+#include <thrust/system/cpp/detail/execution_policy.h>
+#include <thrust/system/detail/internal/eager_future.h>
+#include <thrust/type_traits/void_t.h>
+
+#include <type_traits>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace detail { namespace internal
+{
+
+// the host backends bring these into their namespace with a using-declaration; the
+// policy of the backend is taken exactly, which is preferred to the unimplemented
+// fallback, and only if eager_launch is found for it
+
+// the memory of the C++ system is host memory, so each copy to or from it runs as a
+// copy within the system of the backend, which waits for the dependencies of the
+// policy of the backend. a copy between two different backends is not supported, as
+// neither of them can wait for the dependencies of the other
+
+template <typename FromPolicy, typename ToPolicy, typename = void>
+struct is_same_eager_system : std::false_type {};
+
+template <typename FromPolicy, typename ToPolicy>
+struct is_same_eager_system<
+  FromPolicy, ToPolicy
+, thrust::void_t<eager_system_t<FromPolicy>, eager_system_t<ToPolicy>>
+> : std::is_same<eager_system_t<FromPolicy>, eager_system_t<ToPolicy>> {};
+
+// ADL entry point.
+template <
+  typename FromPolicy, typename ToPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+>
+_CCCL_HOST
+typename std::enable_if<
+  !is_eager_policy<ToPolicy>::value
+  || is_same_eager_system<FromPolicy, ToPolicy>::value
+, eager_event<eager_system_t<FromPolicy>>
+>::type async_copy(
+  FromPolicy&                                              from_exec
+, thrust::system::cpp::detail::execution_policy<ToPolicy>& to_exec
+, ForwardIt                                                first
+, Sentinel                                                 last
+, OutputIt                                                 output
+)
+{
+  THRUST_UNUSED_VAR(to_exec);
+
+  return launch_dependent_event(from_exec, [=] (auto& policy)
+  {
+    thrust::copy(policy, first, last, output);
+  });
+}
+
+// ADL entry point.
+template <
+  typename FromPolicy, typename ToPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+>
+_CCCL_HOST
+typename std::enable_if<
+  !is_eager_policy<FromPolicy>::value
+, eager_event<eager_system_t<ToPolicy>>
+>::type async_copy(
+  thrust::system::cpp::detail::execution_policy<FromPolicy>& from_exec
+, ToPolicy&                                                  to_exec
+, ForwardIt                                                  first
+, Sentinel                                                   last
+, OutputIt                                                   output
+)
+{
+  THRUST_UNUSED_VAR(from_exec);
+
+  return launch_dependent_event(to_exec, [=] (auto& policy)
+  {
+    thrust::copy(policy, first, last, output);
+  });
+}
+
+}}} // namespace system::detail::internal
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp14_required.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <thrust/reduce.h>
+#include <thrust/system/detail/internal/eager_future.h>
+#include <thrust/type_traits/remove_cvref.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace detail { namespace internal
+{
+
+// the host backends bring these into their namespace with a using-declaration; the
+// policy is taken exactly, which is preferred to the unimplemented fallback, and
+// only if eager_launch is found for it
+
+// ADL entry point.
+template <
+  typename DerivedPolicy
+, typename ForwardIt, typename Sentinel, typename T, typename BinaryOp
+>
+_CCCL_HOST
+eager_future<eager_system_t<DerivedPolicy>, remove_cvref_t<T>> async_reduce(
+  DerivedPolicy& exec
+, ForwardIt      first
+, Sentinel       last
+, T              init
+, BinaryOp       op
+)
+{
+  using U = remove_cvref_t<T>;
+
+  return launch_dependent_future<U>(exec, [=] (auto& policy)
+  {
+    return thrust::reduce(policy, first, last, U(init), op);
+  });
+}
+
+// ADL entry point.
+template <
+  typename DerivedPolicy
+, typename ForwardIt, typename Sentinel, typename OutputIt
+, typename T, typename BinaryOp
+>
+_CCCL_HOST
+eager_event<eager_system_t<DerivedPolicy>> async_reduce_into(
+  DerivedPolicy& exec
+, ForwardIt      first
+, Sentinel       last
+, OutputIt       output
+, T              init
+, BinaryOp       op
+)
+{
+  using U = remove_cvref_t<T>;
+
+  return launch_dependent_event(exec, [=] (auto& policy)
+  {
+    *output = thrust::reduce(policy, first, last, U(init), op);
+  });
+}
+
+}}} // namespace system::detail::internal
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
+
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file cache_size.h
+ *  \brief The size of the per-core cache targeted by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+
+#include <cstddef>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the cache size assumed where the system does not report it
+const std::size_t default_cache_size = 1024 * 1024;
+
+
+inline std::size_t query_cache_size()
+{
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+  const long size = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+
+  if(size > 0)
+  {
+    return static_cast<std::size_t>(size);
+  }
+#endif
+
+  return default_cache_size;
+}
+
+
+// the size in bytes of the L2 cache of a core, which bounds the working set that a
+// thread keeps in cache
+inline std::size_t cache_size()
+{
+  static const std::size_t size = query_cache_size();
+  return size;
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,223 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file compact.h
+ *  \brief The steps of the in-place stream compaction and partition shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/copy.h>
+#include <thrust/uninitialized_copy.h>
+#include <thrust/detail/seq.h>
+#include <thrust/system/detail/internal/decompose.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the host backends compact in place in four steps over the tiles of a decomposition:
+//   1. each tile compacts itself to its own front with compact_range_in_place and
+//      records how many elements it kept
+//   2. the counts are scanned into the offset of each tile in the output
+//   3. each tile but the first stashes its kept elements at its offset in a scratch
+//      buffer, less the offset of the second tile
+//   4. each tile but the first restores its elements from the scratch buffer to its
+//      offset in the output
+// the destination of a tile may overlap the kept elements of any earlier tile, so
+// steps 3 and 4 are separated by a barrier; both are parallel over the tiles, and
+// both are skipped when every tile but the last kept all of its elements
+
+
+// compacts the elements [begin, end) to the front of the range and returns how
+// many it kept; an element is only ever written over by a later element, and an
+// element is never written over itself, so the i-th and (i-1)-th elements remain
+// intact until select(i) is evaluated; in particular, a tile never writes its last
+// element, which the next tile inspects
+template<typename RandomAccessIterator, typename Size, typename Selector>
+Size compact_range_in_place(RandomAccessIterator first, Size begin, Size end, Selector select)
+{
+  Size out = begin;
+
+  for(Size j = begin; j < end; ++j)
+  {
+    if(select(j))
+    {
+      if(out != j)
+      {
+        first[out] = first[j];
+      }
+
+      ++out;
+    }
+  }
+
+  return out - begin;
+}
+
+
+// whether the compacted tiles are already at their offsets; offsets holds the
+// scanned counts of step 2
+template<typename Size, typename OffsetIterator>
+bool compacted_tiles_in_place(const uniform_decomposition<Size> &decomp, OffsetIterator offsets)
+{
+  const Size num_tiles = decomp.size();
+
+  return offsets[num_tiles - 1] == decomp[num_tiles - 1].begin();
+}
+
+
+// the number of elements of the scratch buffer of steps 3 and 4
+template<typename Size, typename OffsetIterator>
+Size compacted_scratch_size(const uniform_decomposition<Size> &decomp, OffsetIterator offsets)
+{
+  const Size num_tiles = decomp.size();
+
+  return num_tiles < 2 ? Size(0) : Size(offsets[num_tiles] - offsets[1]);
+}
+
+
+// step 3 for tile i > 0; the scratch buffer is uninitialized
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename OffsetIterator>
+void stash_compacted_tile(RandomAccessIterator1 first,
+                          const uniform_decomposition<Size> &decomp,
+                          OffsetIterator offsets,
+                          Size i,
+                          RandomAccessIterator2 scratch)
+{
+  const Size count = offsets[i + 1] - offsets[i];
+
+  thrust::uninitialized_copy(thrust::seq,
+                             first + decomp[i].begin(),
+                             first + decomp[i].begin() + count,
+                             scratch + (offsets[i] - offsets[1]));
+}
+
+
+// step 4 for tile i > 0
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename OffsetIterator>
+void restore_compacted_tile(RandomAccessIterator1 first,
+                            OffsetIterator offsets,
+                            Size i,
+                            RandomAccessIterator2 scratch)
+{
+  thrust::copy(thrust::seq,
+               scratch + (offsets[i] - offsets[1]),
+               scratch + (offsets[i + 1] - offsets[1]),
+               first + offsets[i]);
+}
+
+
+// partitions the elements [0, n) in place, stably, and returns how many it
+// selected; select(j) is evaluated once, before the j-th element is written over
+// the selected elements are compacted to the front of the range, and the others to
+// the front of buffer, from which they follow the selected elements; buffer is
+// uninitialized, and each of its n elements is constructed once
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename Selector>
+Size partition_range_in_place(RandomAccessIterator1 first, RandomAccessIterator2 buffer, Size n, Selector select)
+{
+  Size true_out = 0, false_out = 0;
+
+  for(Size j = 0; j < n; ++j)
+  {
+    thrust::uninitialized_copy_n(thrust::seq, first + j, 1, buffer + j);
+
+    if(select(j))
+    {
+      first[true_out++] = buffer[j];
+    }
+    else
+    {
+      if(false_out != j)
+      {
+        RandomAccessIterator2 tmp = buffer + false_out;
+        *tmp = buffer[j];
+      }
+
+      ++false_out;
+    }
+  }
+
+  thrust::copy(thrust::seq, buffer, buffer + false_out, first + true_out);
+
+  return true_out;
+}
+
+
+// the first pass of a parallel partition in place over the elements [begin, end):
+// copies the selected ones in order to the front of [begin, end) in buffer and the
+// others in reverse order to its back, and returns how many are selected; select is
+// evaluated once per element and the range is not written, so the second pass needs
+// neither select nor a record of it; buffer is uninitialized, and each of its
+// elements in [begin, end) is constructed once
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size, typename Selector>
+Size stage_partition_range(RandomAccessIterator1 first, RandomAccessIterator2 buffer, Size begin, Size end, Selector select)
+{
+  Size true_out = begin, false_out = end;
+
+  for(Size j = begin; j < end; ++j)
+  {
+    if(select(j))
+    {
+      thrust::uninitialized_copy_n(thrust::seq, first + j, 1, buffer + true_out);
+      ++true_out;
+    }
+    else
+    {
+      --false_out;
+      thrust::uninitialized_copy_n(thrust::seq, first + j, 1, buffer + false_out);
+    }
+  }
+
+  return true_out - begin;
+}
+
+
+// the second pass: writes the elements [begin, end) staged by stage_partition_range,
+// count of which were selected, to true_out and false_out in their original order
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename Size>
+void unstage_partition_range(RandomAccessIterator1 buffer, Size begin, Size end, Size count, RandomAccessIterator2 true_out, RandomAccessIterator2 false_out)
+{
+  thrust::copy(thrust::seq, buffer + begin, buffer + begin + count, true_out);
+
+  for(Size j = end; j != begin + count; ++false_out)
+  {
+    --j;
+    *false_out = buffer[j];
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
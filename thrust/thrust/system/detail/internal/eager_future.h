@@ -0,0 +1,478 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file eager_future.h
+ *  \brief The events and futures shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp14_required.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <thrust/detail/event_error.h>
+#include <thrust/detail/execute_with_dependencies.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/optional.h>
+#include <thrust/type_traits/integer_sequence.h>
+#include <thrust/type_traits/remove_cvref.h>
+#include <thrust/type_traits/void_t.h>
+
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the host backends run the work of an asynchronous algorithm on another thread:
+//   1. the algorithm extracts the dependencies of its policy and binds its policy to its work
+//   2. the backend launches a task which waits for each dependency, then does the work
+//   3. the returned event or future owns the backend's signal of the completion of the task
+// the task owns the dependencies, so they are kept alive until the work has completed
+
+
+// the completion of a task launched by a backend. backends wait for their task
+// when the signal is destroyed, so that no task outlives its event or future
+class eager_signal
+{
+public:
+  virtual ~eager_signal() {}
+
+  virtual bool ready() const = 0;
+
+  // blocks until the task has completed and rethrows its exception, if any
+  virtual void wait() = 0;
+};
+
+
+template<typename System, typename T> class eager_future;
+
+
+// System only distinguishes the events of each backend
+template<typename System>
+class eager_event
+{
+public:
+  eager_event() {}
+
+  explicit eager_event(std::unique_ptr<eager_signal> signal)
+    : m_signal(std::move(signal))
+  {}
+
+  // a future may be explicitly converted to an event, which discards its value
+  template<typename U>
+  explicit eager_event(eager_future<System,U> &&other)
+    : m_signal(std::move(other.m_signal))
+  {
+    other.m_value.reset();
+  }
+
+  eager_event(eager_event &&) = default;
+  eager_event(const eager_event &) = delete;
+  eager_event &operator=(eager_event &&) = default;
+  eager_event &operator=(const eager_event &) = delete;
+
+  bool valid_stream() const noexcept
+  {
+    return bool(m_signal);
+  }
+
+  bool ready() const noexcept
+  {
+    return valid_stream() && m_signal->ready();
+  }
+
+  // blocks
+  void wait()
+  {
+    if(!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    m_signal->wait();
+  }
+
+private:
+  std::unique_ptr<eager_signal> m_signal;
+};
+
+
+template<typename System, typename T>
+class eager_future
+{
+  THRUST_STATIC_ASSERT_MSG(
+    (!std::is_same<T, remove_cvref_t<void>>::value)
+  , "`thrust::event` should be used to express valueless futures"
+  );
+
+public:
+  using value_type = T;
+
+  eager_future() {}
+
+  // value is emplaced by the task which signal waits for
+  eager_future(std::unique_ptr<eager_signal> signal, std::shared_ptr<thrust::optional<T>> value)
+    : m_signal(std::move(signal)), m_value(std::move(value))
+  {}
+
+  eager_future(eager_future &&) = default;
+  eager_future(const eager_future &) = delete;
+  eager_future &operator=(eager_future &&) = default;
+  eager_future &operator=(const eager_future &) = delete;
+
+  bool valid_stream() const noexcept
+  {
+    return bool(m_signal);
+  }
+
+  bool valid_content() const noexcept
+  {
+    return valid_stream() && bool(m_value);
+  }
+
+  bool ready() const noexcept
+  {
+    return valid_stream() && m_signal->ready();
+  }
+
+  // blocks
+  void wait()
+  {
+    if(!valid_stream())
+      throw thrust::event_error(event_errc::no_state);
+
+    m_signal->wait();
+  }
+
+  // blocks
+  value_type get()
+  {
+    if(!valid_content())
+      throw thrust::event_error(event_errc::no_content);
+
+    m_signal->wait();
+
+    return **m_value;
+  }
+
+  // blocks, and leaves the future without state
+  THRUST_NODISCARD value_type extract()
+  {
+    if(!valid_content())
+      throw thrust::event_error(event_errc::no_content);
+
+    m_signal->wait();
+
+    value_type result(std::move(**m_value));
+
+    m_signal.reset();
+    m_value.reset();
+
+    return result;
+  }
+
+private:
+  std::unique_ptr<eager_signal> m_signal;
+  std::shared_ptr<thrust::optional<T>> m_value;
+
+  template<typename, typename> friend class eager_future;
+  template<typename> friend class eager_event;
+};
+
+
+// events and futures are waited for; other dependencies are only kept alive
+template<typename Dependency>
+bool dependency_ready(const Dependency &)
+{
+  return true;
+}
+
+
+template<typename System>
+bool dependency_ready(const eager_event<System> &e)
+{
+  return !e.valid_stream() || e.ready();
+}
+
+
+template<typename System, typename T>
+bool dependency_ready(const eager_future<System,T> &f)
+{
+  return !f.valid_stream() || f.ready();
+}
+
+
+template<typename Dependency>
+void wait_for_dependency(Dependency &)
+{}
+
+
+template<typename System>
+void wait_for_dependency(eager_event<System> &e)
+{
+  if(e.valid_stream()) e.wait();
+}
+
+
+template<typename System, typename T>
+void wait_for_dependency(eager_future<System,T> &f)
+{
+  if(f.valid_stream()) f.wait();
+}
+
+
+template<typename... Dependencies, std::size_t... Is>
+bool dependencies_ready(const std::tuple<Dependencies...> &dependencies, thrust::index_sequence<Is...>)
+{
+  bool ready[] = {true, dependency_ready(std::get<Is>(dependencies))...};
+
+  for(bool r : ready)
+  {
+    if(!r) return false;
+  }
+
+  return true;
+}
+
+
+template<typename... Dependencies, std::size_t... Is>
+void wait_for_dependencies(std::tuple<Dependencies...> &dependencies, thrust::index_sequence<Is...>)
+{
+  int unused[] = {0, (wait_for_dependency(std::get<Is>(dependencies)), 0)...};
+  (void) unused;
+}
+
+
+// the task of step 2
+template<typename Work, typename... Dependencies>
+class dependent_task
+{
+public:
+  dependent_task(Work &&work, std::tuple<Dependencies...> &&dependencies)
+    : m_work(std::move(work)), m_dependencies(std::move(dependencies))
+  {}
+
+  void operator()()
+  {
+    wait_for_dependencies(m_dependencies, thrust::make_index_sequence<sizeof...(Dependencies)>());
+
+    m_work();
+  }
+
+private:
+  Work m_work;
+  std::tuple<Dependencies...> m_dependencies;
+};
+
+
+template<typename Work, typename Dependencies> struct dependent_task_type;
+
+
+template<typename Work, typename... Dependencies>
+struct dependent_task_type<Work, std::tuple<Dependencies...> >
+{
+  typedef dependent_task<Work, Dependencies...> type;
+};
+
+
+// the task shared by copies of a shared_task, since backends may copy what they launch
+template<typename Task>
+struct shared_task
+{
+  std::shared_ptr<Task> task;
+
+  void operator()() const
+  {
+    (*task)();
+  }
+};
+
+
+// the work of step 1; policies with dependencies are not copyable, so the
+// policy is moved, after its dependencies have been extracted
+template<typename DerivedPolicy, typename Function>
+class policy_work
+{
+public:
+  policy_work(DerivedPolicy &&policy, Function f)
+    : m_policy(std::move(policy)), m_f(f)
+  {}
+
+  auto operator()() -> decltype(std::declval<Function&>()(std::declval<DerivedPolicy&>()))
+  {
+    return m_f(m_policy);
+  }
+
+private:
+  DerivedPolicy m_policy;
+  Function m_f;
+};
+
+
+template<typename T, typename Work>
+class emplace_result
+{
+public:
+  emplace_result(std::shared_ptr<thrust::optional<T>> result, Work &&work)
+    : m_result(std::move(result)), m_work(std::move(work))
+  {}
+
+  void operator()()
+  {
+    m_result->emplace(m_work());
+  }
+
+private:
+  std::shared_ptr<thrust::optional<T>> m_result;
+  Work m_work;
+};
+
+
+// Launch is a function of a shared_task returning the backend's eager_signal,
+// and f is a function of the policy to which the algorithm is dispatched
+template<typename System, typename Launch, typename DerivedPolicy, typename Function>
+eager_event<System> make_dependent_event(Launch launch, DerivedPolicy &policy, Function f)
+{
+  auto dependencies = thrust::detail::extract_dependencies(std::move(policy));
+
+  using work_type = policy_work<DerivedPolicy, Function>;
+  using task_type = typename dependent_task_type<work_type, decltype(dependencies)>::type;
+
+  std::shared_ptr<task_type> task = std::make_shared<task_type>(work_type(std::move(policy), f), std::move(dependencies));
+
+  return eager_event<System>(launch(shared_task<task_type>{std::move(task)}));
+}
+
+
+template<typename System, typename T, typename Launch, typename DerivedPolicy, typename Function>
+eager_future<System,T> make_dependent_future(Launch launch, DerivedPolicy &policy, Function f)
+{
+  auto dependencies = thrust::detail::extract_dependencies(std::move(policy));
+
+  std::shared_ptr<thrust::optional<T>> result = std::make_shared<thrust::optional<T>>();
+
+  using work_type = emplace_result<T, policy_work<DerivedPolicy, Function>>;
+  using task_type = typename dependent_task_type<work_type, decltype(dependencies)>::type;
+
+  std::shared_ptr<task_type> task =
+    std::make_shared<task_type>(work_type(result, policy_work<DerivedPolicy, Function>(std::move(policy), f)), std::move(dependencies));
+
+  return eager_future<System,T>(launch(shared_task<task_type>{std::move(task)}), std::move(result));
+}
+
+
+// the asynchronous algorithms of internal/async are shared by the backends, each of
+// which provides eager_launch(exec), found by ADL, returning the Launch of its policy.
+// the nested system_tag of that Launch distinguishes the events of the backend
+template<typename DerivedPolicy>
+using eager_system_t = typename decltype(eager_launch(std::declval<DerivedPolicy&>()))::system_tag;
+
+
+template<typename DerivedPolicy, typename = void>
+struct is_eager_policy : std::false_type {};
+
+
+template<typename DerivedPolicy>
+struct is_eager_policy<DerivedPolicy, thrust::void_t<eager_system_t<DerivedPolicy>>> : std::true_type {};
+
+
+template<typename DerivedPolicy, typename Function>
+eager_event<eager_system_t<DerivedPolicy>> launch_dependent_event(DerivedPolicy &policy, Function f)
+{
+  // the launch is taken before the policy is moved into the task
+  auto launch = eager_launch(policy);
+
+  return thrust::system::detail::internal::make_dependent_event<eager_system_t<DerivedPolicy>>(launch, policy, f);
+}
+
+
+template<typename T, typename DerivedPolicy, typename Function>
+eager_future<eager_system_t<DerivedPolicy>,T> launch_dependent_future(DerivedPolicy &policy, Function f)
+{
+  auto launch = eager_launch(policy);
+
+  return thrust::system::detail::internal::make_dependent_future<eager_system_t<DerivedPolicy>,T>(launch, policy, f);
+}
+
+
+// the signal of when_all, which launches no task
+template<typename... Dependencies>
+class joined_signal : public eager_signal
+{
+public:
+  explicit joined_signal(std::tuple<Dependencies...> &&dependencies)
+    : m_dependencies(std::move(dependencies))
+  {}
+
+  bool ready() const
+  {
+    return dependencies_ready(m_dependencies, thrust::make_index_sequence<sizeof...(Dependencies)>());
+  }
+
+  void wait()
+  {
+    wait_for_dependencies(m_dependencies, thrust::make_index_sequence<sizeof...(Dependencies)>());
+  }
+
+private:
+  std::tuple<Dependencies...> m_dependencies;
+};
+
+
+template<typename System, typename... Dependencies>
+eager_event<System> make_joined_event(std::tuple<Dependencies...> &&dependencies)
+{
+  return eager_event<System>(std::unique_ptr<eager_signal>(new joined_signal<Dependencies...>(std::move(dependencies))));
+}
+
+
+// ADL hooks for transparent `.after` move support
+template<typename System>
+auto capture_as_dependency(eager_event<System> &dependency)
+THRUST_DECLTYPE_RETURNS(std::move(dependency))
+
+
+template<typename System, typename T>
+auto capture_as_dependency(eager_future<System,T> &dependency)
+THRUST_DECLTYPE_RETURNS(std::move(dependency))
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#endif // C++14
+
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file find_if.h
+ *  \brief The blocked early-exit search shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/minmax.h>
+
+#include <atomic>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the host backends search blocks of this many elements at a time, and check
+// between blocks whether a match earlier in the range has made the rest moot
+const int find_if_block_size = 4096;
+
+
+// the position of the first match found so far by any thread
+template<typename IndexType>
+class first_match
+{
+public:
+  explicit first_match(IndexType n)
+    : position(n)
+  {}
+
+  IndexType get() const
+  {
+    return position.load(std::memory_order_relaxed);
+  }
+
+  void update(IndexType i)
+  {
+    IndexType current = get();
+
+    while(i < current && !position.compare_exchange_weak(current, i, std::memory_order_relaxed))
+    {}
+  }
+
+private:
+  std::atomic<IndexType> position;
+};
+
+
+// searches first[begin, end) for a match of pred, abandoning the search as soon as
+// a match at or before the block under consideration has been found
+template<typename RandomAccessIterator, typename IndexType, typename Predicate>
+void find_if_block(RandomAccessIterator first,
+                   IndexType begin,
+                   IndexType end,
+                   Predicate pred,
+                   first_match<IndexType> &result)
+{
+  for(IndexType block = begin; block < end; block += find_if_block_size)
+  {
+    if(result.get() <= block) return;
+
+    const IndexType block_end = thrust::min<IndexType>(block + find_if_block_size, end);
+
+    for(IndexType i = block; i < block_end; ++i)
+    {
+      if(pred(first[i]))
+      {
+        result.update(i);
+        return;
+      }
+    }
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file merge_path.h
+ *  \brief Partitioning of pairs of sorted ranges along their merge path,
+ *         shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/pair.h>
+#include <thrust/iterator/iterator_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// returns the number of elements of [first1, first1 + n1) which precede the
+// diag-th element of the stable merge of [first1, first1 + n1) and [first2, first2 + n2)
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename IndexType,
+         typename StrictWeakOrdering>
+IndexType merge_path(RandomAccessIterator1 first1, IndexType n1,
+                     RandomAccessIterator2 first2, IndexType n2,
+                     IndexType diag,
+                     StrictWeakOrdering comp)
+{
+  IndexType lo = (diag > n2) ? diag - n2 : IndexType(0);
+  IndexType hi = (diag < n1) ? diag : n1;
+
+  while(lo < hi)
+  {
+    IndexType mid = lo + (hi - lo) / 2;
+
+    // ties are taken from the first range, which preserves stability
+    if(comp(first2[diag - 1 - mid], first1[mid]))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+
+// returns the position of the first element of [first, first + n) which is not less than x
+template<typename RandomAccessIterator, typename IndexType, typename T, typename StrictWeakOrdering>
+IndexType lower_bound_index(RandomAccessIterator first, IndexType n, const T &x, StrictWeakOrdering comp)
+{
+  IndexType lo = 0;
+  IndexType hi = n;
+
+  while(lo < hi)
+  {
+    IndexType mid = lo + (hi - lo) / 2;
+
+    if(comp(first[mid], x))
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+
+// splits both ranges at the diag-th element of their merge, then moves the split back
+// to the start of the run of equivalent elements containing that element
+// no run of equivalent elements of either range straddles the split, so set operations
+// on the two halves of the ranges may proceed independently
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename IndexType,
+         typename StrictWeakOrdering>
+thrust::pair<IndexType,IndexType>
+  run_aligned_merge_path(RandomAccessIterator1 first1, IndexType n1,
+                         RandomAccessIterator2 first2, IndexType n2,
+                         IndexType diag,
+                         StrictWeakOrdering comp)
+{
+  const IndexType i = merge_path(first1, n1, first2, n2, diag, comp);
+  const IndexType j = diag - i;
+
+  if(i == n1 && j == n2)
+  {
+    return thrust::make_pair(i, j);
+  }
+
+  // every element before the split is no greater than the diag-th element of the merge
+  if(j == n2 || (i < n1 && !comp(first2[j], first1[i])))
+  {
+    typename thrust::iterator_value<RandomAccessIterator1>::type x = first1[i];
+
+    return thrust::make_pair(lower_bound_index(first1, i, x, comp), lower_bound_index(first2, j, x, comp));
+  }
+  else
+  {
+    typename thrust::iterator_value<RandomAccessIterator2>::type x = first2[j];
+
+    return thrust::make_pair(lower_bound_index(first1, i, x, comp), lower_bound_index(first2, j, x, comp));
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,202 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file radix_sort.h
+ *  \brief Building blocks of the tiled LSD radix sort shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/functional.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/sequential/stable_radix_sort.h>
+
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace radix_sort_detail
+{
+
+
+// every pass sorts one 8-bit digit, from least to most significant
+const unsigned int radix_bits = 8;
+const unsigned int radix_size = 1 << radix_bits;
+
+
+// below this size, the sequential radix sort beats the cost of the per-tile histograms
+const std::size_t parallel_threshold = 1 << 15;
+
+
+// the parallel radix sort applies to the same keys and comparisons as the
+// sequential primitive sort, except bool, which sequential handles with a partition,
+// and keys such as long double which have no integral encoding
+template<typename KeyType, typename Compare>
+struct use_radix_sort
+  : thrust::detail::and_<
+      thrust::detail::is_arithmetic<KeyType>,
+      thrust::detail::not_<thrust::detail::is_same<KeyType, bool> >,
+      thrust::detail::is_integral<
+        typename thrust::system::detail::sequential::radix_sort_detail::RadixEncoder<KeyType>::result_type
+      >,
+      thrust::detail::or_<
+        thrust::detail::is_same<Compare, thrust::less<KeyType> >,
+        thrust::detail::is_same<Compare, thrust::greater<KeyType> >
+      >
+    >
+{};
+
+
+// maps keys to unsigned integers whose ascending order is the order requested by Compare
+// complementing the encoding sorts in descending order while leaving equal keys in place,
+// so unlike the sequential sort, greater<T> needs no reversals to remain stable
+template<typename KeyType, typename Compare>
+struct radix_encoder
+{
+  typedef thrust::system::detail::sequential::radix_sort_detail::RadixEncoder<KeyType> base_encoder;
+  typedef typename base_encoder::result_type                                           encoded_type;
+
+  static const bool descending = thrust::detail::is_same<Compare, thrust::greater<KeyType> >::value;
+
+  static const unsigned int num_passes = sizeof(encoded_type);
+
+  encoded_type operator()(KeyType key) const
+  {
+    const encoded_type x = static_cast<encoded_type>(base_encoder()(key));
+
+    return descending ? static_cast<encoded_type>(~x) : x;
+  }
+
+  std::size_t digit(KeyType key, unsigned int pass) const
+  {
+    return static_cast<std::size_t>((operator()(key) >> (radix_bits * pass)) & (radix_size - 1));
+  }
+};
+
+
+// counts the keys of one tile falling into each bucket of the given pass
+template<typename Encoder, typename RandomAccessIterator, typename IndexType>
+void histogram_tile(RandomAccessIterator keys,
+                    const index_range<IndexType> &tile,
+                    unsigned int pass,
+                    std::size_t *histogram)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type KeyType;
+
+  Encoder encode;
+
+  for(unsigned int i = 0; i < radix_size; ++i)
+  {
+    histogram[i] = 0;
+  }
+
+  for(IndexType i = tile.begin(); i < tile.end(); ++i)
+  {
+    ++histogram[encode.digit(KeyType(keys[i]), pass)];
+  }
+}
+
+
+// turns the per-tile histograms, stored tile after tile, into the offset in the output
+// of each tile's first key in each bucket
+// returns false when all n keys share a bucket, in which case the pass may be skipped
+inline bool scan_histograms(std::size_t *histograms, std::size_t num_tiles, std::size_t n)
+{
+  std::size_t sum = 0;
+
+  for(unsigned int bucket = 0; bucket < radix_size; ++bucket)
+  {
+    const std::size_t bucket_first = sum;
+
+    for(std::size_t tile = 0; tile < num_tiles; ++tile)
+    {
+      const std::size_t count = histograms[tile * radix_size + bucket];
+
+      histograms[tile * radix_size + bucket] = sum;
+
+      sum += count;
+    }
+
+    if(sum - bucket_first == n)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+// moves the keys (and optionally the values) of one tile to their positions for the given pass,
+// advancing the tile's offsets as it goes; keys are visited in order, which keeps the pass stable
+template<typename Encoder,
+         bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename IndexType>
+void scatter_tile(RandomAccessIterator1 keys_first,
+                  RandomAccessIterator2 values_first,
+                  RandomAccessIterator3 keys_result,
+                  RandomAccessIterator4 values_result,
+                  const index_range<IndexType> &tile,
+                  unsigned int pass,
+                  std::size_t *offsets)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type KeyType;
+
+  Encoder encode;
+
+  for(IndexType i = tile.begin(); i < tile.end(); ++i)
+  {
+    const KeyType key = keys_first[i];
+
+    const std::size_t j = offsets[encode.digit(key, pass)]++;
+
+    keys_result[j] = key;
+
+    if(HasValues)
+    {
+      values_result[j] = values_first[i];
+    }
+  }
+}
+
+
+} // end namespace radix_sort_detail
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,218 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file shuffle.h
+ *  \brief The bucketed shuffle shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/minmax.h>
+#include <thrust/swap.h>
+
+#include <cstdint>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the counts of step 1 below number the blocks times the buckets, so the number of
+// blocks is bounded for the counts to grow only with the number of buckets
+const std::uint64_t shuffle_max_blocks = 1 << 8;
+
+
+// the bytes a bucket holds on average; half of the L2 cache of most cores, which leaves room
+// for the output. the permutation depends on the size of a bucket, so it is fixed rather
+// than taken from the cache of the host, for a seed to yield the same permutation on every machine
+const std::uint64_t shuffle_bucket_bytes = 1 << 19;
+
+
+// the number of elements of the given size which a bucket holds on average
+inline std::uint64_t shuffle_bucket_size(std::size_t element_size)
+{
+  return thrust::max<std::uint64_t>(1, shuffle_bucket_bytes / element_size);
+}
+
+
+// the host backends shuffle in four steps:
+//   1. the input is cut into num_blocks() blocks, and each block counts how many of its
+//      elements fall into each of the num_buckets() buckets; element i falls into bucket(i)
+//   2. the counts are scanned into the position of each block's share of each bucket
+//   3. each block scatters its elements to their buckets in a temporary buffer
+//   4. each bucket is shuffled with Fisher-Yates and copied to the output
+// an element lands in a uniformly random bucket and each bucket is uniformly shuffled, so
+// every permutation is equally likely. the buckets, the blocks and the random streams depend
+// only on the size of the input, the size of a bucket and the values drawn from the
+// generator, so a given seed yields the same permutation however many threads take part
+class bucket_shuffle
+{
+public:
+  template<typename URBG>
+  bucket_shuffle(std::uint64_t n, std::uint64_t bucket_size, URBG &&g)
+    : m_num_buckets(thrust::max<std::uint64_t>(1, (n + bucket_size - 1) / bucket_size)),
+      m_num_blocks(thrust::min<std::uint64_t>(shuffle_max_blocks, m_num_buckets))
+  {
+    // generators may return fewer than 64 random bits; the draws are sequenced, as the
+    // operands of an expression may be evaluated in any order
+    const std::uint64_t high = static_cast<std::uint64_t>(g());
+    const std::uint64_t seed = (high << 32) ^ static_cast<std::uint64_t>(g());
+
+    m_bucket_seed  = mix(seed);
+    m_shuffle_seed = mix(seed ^ UINT64_C(0xD1B54A32D192ED03));
+  }
+
+  std::uint64_t num_buckets() const
+  {
+    return m_num_buckets;
+  }
+
+  std::uint64_t num_blocks() const
+  {
+    return m_num_blocks;
+  }
+
+  // the bucket into which the i-th element of the input falls
+  std::uint64_t bucket(std::uint64_t i) const
+  {
+    return ((mix(m_bucket_seed + (i + 1) * golden_gamma) >> 32) * m_num_buckets) >> 32;
+  }
+
+  // shuffles the n elements of bucket b, which begin at first
+  template<typename T, typename Size>
+  void shuffle_bucket(T *first, Size n, std::uint64_t b) const
+  {
+    if(n < 2) return;
+
+    std::uint64_t state = mix(m_shuffle_seed + (b + 1) * golden_gamma);
+
+    for(Size k = n - 1; k > 0; --k)
+    {
+      state += golden_gamma;
+
+      const Size j = static_cast<Size>(mix(state) % static_cast<std::uint64_t>(k + 1));
+
+      thrust::swap(first[k], first[j]);
+    }
+  }
+
+private:
+  static constexpr std::uint64_t golden_gamma = UINT64_C(0x9E3779B97F4A7C15);
+
+  // the finalizer of splitmix64
+  static std::uint64_t mix(std::uint64_t x)
+  {
+    x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return x ^ (x >> 31);
+  }
+
+  std::uint64_t m_num_buckets;
+  std::uint64_t m_num_blocks;
+  std::uint64_t m_bucket_seed;
+  std::uint64_t m_shuffle_seed;
+};
+
+
+// step 1 for the elements [begin, end) of a block; counts is the block's row of num_buckets() counts
+template<typename Size>
+void count_buckets(const bucket_shuffle &shuffler, Size begin, Size end, Size *counts)
+{
+  for(std::uint64_t b = 0; b < shuffler.num_buckets(); ++b)
+  {
+    counts[b] = 0;
+  }
+
+  for(Size i = begin; i < end; ++i)
+  {
+    ++counts[shuffler.bucket(i)];
+  }
+}
+
+
+// step 2: replaces the count of each block and bucket with the position of its elements,
+// and sets bucket_begin[b] to the position of bucket b; bucket_begin[num_buckets()] becomes n
+template<typename Size>
+void scan_buckets(const bucket_shuffle &shuffler, Size *counts, Size *bucket_begin)
+{
+  const Size num_buckets = static_cast<Size>(shuffler.num_buckets());
+  const Size num_blocks  = static_cast<Size>(shuffler.num_blocks());
+
+  Size sum = 0;
+
+  for(Size b = 0; b < num_buckets; ++b)
+  {
+    bucket_begin[b] = sum;
+
+    for(Size block = 0; block < num_blocks; ++block)
+    {
+      const Size count = counts[block * num_buckets + b];
+      counts[block * num_buckets + b] = sum;
+      sum += count;
+    }
+  }
+
+  bucket_begin[num_buckets] = sum;
+}
+
+
+// step 3 for the elements [begin, end) of a block; positions is the block's row of scanned counts
+template<typename RandomAccessIterator, typename T, typename Size>
+void scatter_buckets(const bucket_shuffle &shuffler, RandomAccessIterator first, Size begin, Size end, T *buffer, Size *positions)
+{
+  for(Size i = begin; i < end; ++i)
+  {
+    buffer[positions[shuffler.bucket(i)]++] = first[i];
+  }
+}
+
+
+// step 4 for bucket b
+template<typename T, typename Size, typename OutputIterator>
+void shuffle_bucket(const bucket_shuffle &shuffler, T *buffer, const Size *bucket_begin, Size b, OutputIterator result)
+{
+  const Size begin = bucket_begin[b];
+  const Size end   = bucket_begin[b + 1];
+
+  shuffler.shuffle_bucket(buffer + begin, end - begin, static_cast<std::uint64_t>(b));
+
+  for(Size i = begin; i < end; ++i)
+  {
+    OutputIterator out = result + i;
+    *out = buffer[i];
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,351 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file temporary_pool.h
+ *  \brief The per-thread pools of temporary storage shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp11_required.h>
+
+#if _CCCL_STD_VER >= 2011
+
+#include <thrust/detail/integer_math.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/type_traits/pointer_traits.h>
+#include <thrust/mr/new.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+class temporary_pool;
+
+
+// the pools of every live thread, so that the storage cached by all of them may be released
+class temporary_pool_registry
+{
+public:
+  void add(temporary_pool *pool)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pools.push_back(pool);
+  }
+
+  void remove(temporary_pool *pool)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pools.erase(std::find(m_pools.begin(), m_pools.end(), pool));
+  }
+
+  // defined below temporary_pool
+  void release_all();
+
+  static temporary_pool_registry &get()
+  {
+    static temporary_pool_registry registry;
+    return registry;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<temporary_pool*> m_pools;
+};
+
+
+// a cache of the temporary storage of one thread. storage is allocated in
+// power-of-two size classes, so that a block returned to the pool is reused by
+// any request of the same class; pages past the end of a request are never touched.
+// temporary storage is allocated and returned by the thread which invokes an
+// algorithm, so the lock of a pool is only contended while another thread releases it
+class temporary_pool
+{
+public:
+  // the alignment of every cached block; a cache line, so that the temporary
+  // storage of different threads never shares one
+  static const std::size_t alignment = 64;
+
+  // a pool caches at most this many bytes; blocks returned past it go back to the system
+  static const std::size_t max_cached_bytes = std::size_t(1) << 28;
+
+  temporary_pool()
+    : m_cached_bytes(0)
+  {
+    temporary_pool_registry::get().add(this);
+  }
+
+  temporary_pool(const temporary_pool &) = delete;
+  temporary_pool &operator=(const temporary_pool &) = delete;
+
+  ~temporary_pool()
+  {
+    temporary_pool_registry::get().remove(this);
+    release();
+  }
+
+  void *allocate(std::size_t bytes)
+  {
+    const std::size_t c = size_class(bytes);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(c >= m_free.size())
+    {
+      m_free.resize(c + 1);
+      m_live.resize(c + 1, 0);
+    }
+
+    if(!m_free[c].empty())
+    {
+      void *p = m_free[c].back();
+      m_free[c].pop_back();
+      m_cached_bytes -= std::size_t(1) << c;
+      ++m_live[c];
+      return p;
+    }
+
+    void *p = m_upstream.do_allocate(std::size_t(1) << c, alignment);
+
+    // make room in the free list for every block of the class in use, so that
+    // deallocate never allocates
+    try
+    {
+      m_free[c].reserve(m_free[c].size() + m_live[c] + 1);
+    }
+    catch(...)
+    {
+      m_upstream.do_deallocate(p, std::size_t(1) << c, alignment);
+      throw;
+    }
+
+    ++m_live[c];
+    return p;
+  }
+
+  void deallocate(void *p, std::size_t bytes) noexcept
+  {
+    const std::size_t c = size_class(bytes);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if(c < m_live.size() && m_live[c] > 0)
+    {
+      --m_live[c];
+    }
+
+    // a block of another pool may find no room in the free list
+    if(c >= m_free.size() ||
+       m_free[c].size() == m_free[c].capacity() ||
+       m_cached_bytes + (std::size_t(1) << c) > max_cached_bytes)
+    {
+      m_upstream.do_deallocate(p, std::size_t(1) << c, alignment);
+      return;
+    }
+
+    m_free[c].push_back(p);
+    m_cached_bytes += std::size_t(1) << c;
+  }
+
+  // returns every cached block to the system; blocks which are still in use are
+  // cached again when they are returned to the pool
+  void release()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for(std::size_t c = 0; c < m_free.size(); ++c)
+    {
+      for(std::size_t i = 0; i < m_free[c].size(); ++i)
+      {
+        m_upstream.do_deallocate(m_free[c][i], std::size_t(1) << c, alignment);
+      }
+
+      m_free[c].clear();
+    }
+
+    m_cached_bytes = 0;
+  }
+
+  std::size_t cached_bytes()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cached_bytes;
+  }
+
+private:
+  static std::size_t size_class(std::size_t bytes)
+  {
+    if(bytes < alignment)
+    {
+      bytes = alignment;
+    }
+
+    return thrust::detail::log2_ri(bytes);
+  }
+
+  std::mutex m_mutex;
+  thrust::mr::new_delete_resource m_upstream;
+  std::vector<std::vector<void*> > m_free;
+
+  // the number of blocks of each class allocated by the pool and not yet returned
+  std::vector<std::size_t> m_live;
+
+  std::size_t m_cached_bytes;
+};
+
+
+inline void temporary_pool_registry::release_all()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for(std::size_t i = 0; i < m_pools.size(); ++i)
+  {
+    m_pools[i]->release();
+  }
+}
+
+
+inline temporary_pool &tls_temporary_pool()
+{
+  static thread_local temporary_pool pool;
+  return pool;
+}
+
+
+// storage which requires a stricter alignment than the pool provides is not cached
+template<typename T>
+T *allocate_temporary(std::ptrdiff_t n)
+{
+  const std::size_t bytes = sizeof(T) * static_cast<std::size_t>(n);
+
+  if(alignof(T) > temporary_pool::alignment)
+  {
+    return static_cast<T*>(thrust::mr::new_delete_resource().do_allocate(bytes, alignof(T)));
+  }
+
+  return static_cast<T*>(tls_temporary_pool().allocate(bytes));
+}
+
+
+template<typename T>
+void deallocate_temporary(T *p, std::ptrdiff_t n)
+{
+  const std::size_t bytes = sizeof(T) * static_cast<std::size_t>(n);
+
+  if(alignof(T) > temporary_pool::alignment)
+  {
+    thrust::mr::new_delete_resource().do_deallocate(p, bytes, alignof(T));
+    return;
+  }
+
+  tls_temporary_pool().deallocate(p, bytes);
+}
+
+
+namespace temporary_pool_detail
+{
+
+
+struct not_customized {};
+
+
+// hides the return_temporary_buffer of the enclosing namespaces, and is a better match
+// than the generic return_temporary_buffer found by argument-dependent lookup, so that
+// a call only resolves elsewhere when a policy customizes return_temporary_buffer
+template<typename DerivedPolicy, typename Pointer>
+not_customized return_temporary_buffer(DerivedPolicy &, Pointer);
+
+
+template<typename DerivedPolicy, typename Pointer>
+struct has_two_argument_return
+  : thrust::detail::integral_constant<
+      bool,
+      !thrust::detail::is_same<
+        decltype(return_temporary_buffer(std::declval<DerivedPolicy&>(), std::declval<Pointer>())),
+        not_customized
+      >::value
+    >
+{};
+
+
+template<typename DerivedPolicy, typename Pointer>
+void return_temporary(DerivedPolicy &exec, Pointer p, std::ptrdiff_t, thrust::detail::true_type)
+{
+  return_temporary_buffer(exec, p);
+}
+
+
+template<typename DerivedPolicy, typename Pointer>
+void return_temporary(DerivedPolicy &, Pointer p, std::ptrdiff_t n, thrust::detail::false_type)
+{
+  typedef typename thrust::detail::pointer_traits<Pointer>::element_type T;
+
+  deallocate_temporary<T>(thrust::raw_pointer_cast(p), n);
+}
+
+
+} // end temporary_pool_detail
+
+
+// returns a temporary buffer of exec to the pool, unless a policy derived from a host
+// backend's customizes the older return_temporary_buffer without a size, as the
+// generic return_temporary_buffer would call it
+template<typename DerivedPolicy, typename Pointer>
+void return_temporary(DerivedPolicy &exec, Pointer p, std::ptrdiff_t n)
+{
+  typedef temporary_pool_detail::has_two_argument_return<DerivedPolicy,Pointer> customized;
+
+  temporary_pool_detail::return_temporary(exec, p, n, typename customized::type());
+}
+
+
+// returns every block cached by the pools of all threads to the system
+inline void release_temporary_pool()
+{
+  temporary_pool_registry::get().release_all();
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#endif // _CCCL_STD_VER >= 2011
+
@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file transform_reduce.h
+ *  \brief The tile reductions behind transform_reduce, inner_product and count_if,
+ *         shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/raw_reference_cast.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+
+
+// the generic layer reduces these algorithms through a transform_iterator over a
+// zip_iterator, which hides the contiguous loads from the compiler; the host backends
+// instead reduce a function of the index, so a tile is a plain loop over the inputs
+
+template<typename RandomAccessIterator, typename UnaryFunction, typename OutputType>
+struct transform_at
+{
+  RandomAccessIterator first;
+  UnaryFunction unary_op;
+
+  transform_at(RandomAccessIterator first, UnaryFunction unary_op)
+    : first(first), unary_op(unary_op)
+  {}
+
+  template<typename Size>
+  OutputType operator()(Size i)
+  {
+    return unary_op(thrust::raw_reference_cast(first[i]));
+  }
+};
+
+
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename BinaryFunction, typename OutputType>
+struct inner_product_at
+{
+  RandomAccessIterator1 first1;
+  RandomAccessIterator2 first2;
+  BinaryFunction binary_op;
+
+  inner_product_at(RandomAccessIterator1 first1, RandomAccessIterator2 first2, BinaryFunction binary_op)
+    : first1(first1), first2(first2), binary_op(binary_op)
+  {}
+
+  template<typename Size>
+  OutputType operator()(Size i)
+  {
+    return binary_op(thrust::raw_reference_cast(first1[i]), thrust::raw_reference_cast(first2[i]));
+  }
+};
+
+
+template<typename RandomAccessIterator, typename Predicate, typename CountType>
+struct count_if_at
+{
+  RandomAccessIterator first;
+  Predicate pred;
+
+  count_if_at(RandomAccessIterator first, Predicate pred)
+    : first(first), pred(pred)
+  {}
+
+  template<typename Size>
+  CountType operator()(Size i)
+  {
+    return pred(thrust::raw_reference_cast(first[i])) ? CountType(1) : CountType(0);
+  }
+};
+
+
+template<typename RandomAccessIterator, typename OutputType>
+struct element_at
+{
+  RandomAccessIterator first;
+
+  element_at(RandomAccessIterator first)
+    : first(first)
+  {}
+
+  template<typename Size>
+  OutputType operator()(Size i)
+  {
+    return thrust::raw_reference_cast(first[i]);
+  }
+};
+
+
+// the number of sums that reduce_tile accumulates independently, so that the latency
+// of binary_op is hidden rather than paid once per element
+const int reduce_tile_sums = 4;
+
+
+// returns f(begin) reduced with f(begin + 1), ..., f(end - 1); the tile must not be empty
+// the tile is split into reduce_tile_sums consecutive parts which are reduced side by
+// side and then in order, so binary_op need only be associative
+template<typename OutputType, typename Size, typename IndexFunction, typename BinaryFunction>
+OutputType reduce_tile(Size begin, Size end, IndexFunction f, BinaryFunction binary_op)
+{
+  const Size part = (end - begin) / reduce_tile_sums;
+
+  if(part < 2)
+  {
+    OutputType sum = f(begin);
+
+    for(Size i = begin + 1; i < end; ++i)
+    {
+      sum = binary_op(sum, f(i));
+    }
+
+    return sum;
+  }
+
+  const Size begin1 = begin  + part;
+  const Size begin2 = begin1 + part;
+  const Size begin3 = begin2 + part;
+
+  OutputType sum0 = f(begin);
+  OutputType sum1 = f(begin1);
+  OutputType sum2 = f(begin2);
+  OutputType sum3 = f(begin3);
+
+  for(Size i = 1; i < part; ++i)
+  {
+    sum0 = binary_op(sum0, f(begin  + i));
+    sum1 = binary_op(sum1, f(begin1 + i));
+    sum2 = binary_op(sum2, f(begin2 + i));
+    sum3 = binary_op(sum3, f(begin3 + i));
+  }
+
+  // the last part takes the remainder of the tile
+  for(Size i = begin3 + part; i < end; ++i)
+  {
+    sum3 = binary_op(sum3, f(i));
+  }
+
+  return binary_op(binary_op(sum0, sum1), binary_op(sum2, sum3));
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
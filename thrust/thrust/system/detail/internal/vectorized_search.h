@@ -0,0 +1,226 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file vectorized_search.h
+ *  \brief Searches of many values in a sorted range, shared by the host parallel backends.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/integer_math.h>
+#include <thrust/system/detail/internal/merge_path.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace detail
+{
+namespace internal
+{
+namespace vectorized_search_detail
+{
+
+
+// each search describes how the vectorized lower_bound, upper_bound and binary_search
+// locate a value v in a sorted range [first, first + n):
+//   probe(first, n, v, comp) searches for v alone
+//   precedes(x, v, comp) is true when the element x of the range lies before the position of v
+//   result(first, n, i, v, comp) produces the output for v, given its position i
+//   values_before(...) locates a tile boundary along the merge path of the range and
+//   sorted values, merging equivalent elements in the order precedes() implies
+
+
+struct lower_bound_search
+{
+  template<typename RandomAccessIterator, typename IndexType, typename T, typename StrictWeakOrdering>
+  static IndexType probe(RandomAccessIterator first, IndexType n, const T &v, StrictWeakOrdering comp)
+  {
+    return thrust::system::detail::internal::lower_bound_index(first, n, v, comp);
+  }
+
+  template<typename T1, typename T2, typename StrictWeakOrdering>
+  static bool precedes(const T1 &x, const T2 &v, StrictWeakOrdering comp)
+  {
+    return comp(x, v);
+  }
+
+  template<typename RandomAccessIterator, typename IndexType, typename T, typename StrictWeakOrdering>
+  static IndexType result(RandomAccessIterator, IndexType, IndexType i, const T &, StrictWeakOrdering)
+  {
+    return i;
+  }
+
+  // a value precedes the elements of the range equivalent to it
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename IndexType, typename StrictWeakOrdering>
+  static IndexType values_before(RandomAccessIterator1 first, IndexType n,
+                                 RandomAccessIterator2 values, IndexType m,
+                                 IndexType diag,
+                                 StrictWeakOrdering comp)
+  {
+    return thrust::system::detail::internal::merge_path(values, m, first, n, diag, comp);
+  }
+};
+
+
+struct upper_bound_search
+{
+  template<typename RandomAccessIterator, typename IndexType, typename T, typename StrictWeakOrdering>
+  static IndexType probe(RandomAccessIterator first, IndexType n, const T &v, StrictWeakOrdering comp)
+  {
+    IndexType lo = 0;
+    IndexType hi = n;
+
+    while(lo < hi)
+    {
+      IndexType mid = lo + (hi - lo) / 2;
+
+      if(comp(v, first[mid]))
+      {
+        hi = mid;
+      }
+      else
+      {
+        lo = mid + 1;
+      }
+    }
+
+    return lo;
+  }
+
+  template<typename T1, typename T2, typename StrictWeakOrdering>
+  static bool precedes(const T1 &x, const T2 &v, StrictWeakOrdering comp)
+  {
+    return !comp(v, x);
+  }
+
+  template<typename RandomAccessIterator, typename IndexType, typename T, typename StrictWeakOrdering>
+  static IndexType result(RandomAccessIterator, IndexType, IndexType i, const T &, StrictWeakOrdering)
+  {
+    return i;
+  }
+
+  // a value follows the elements of the range equivalent to it
+  template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename IndexType, typename StrictWeakOrdering>
+  static IndexType values_before(RandomAccessIterator1 first, IndexType n,
+                                 RandomAccessIterator2 values, IndexType m,
+                                 IndexType diag,
+                                 StrictWeakOrdering comp)
+  {
+    return diag - thrust::system::detail::internal::merge_path(first, n, values, m, diag, comp);
+  }
+};
+
+
+struct binary_search_search : lower_bound_search
+{
+  template<typename RandomAccessIterator, typename IndexType, typename T, typename StrictWeakOrdering>
+  static bool result(RandomAccessIterator first, IndexType n, IndexType i, const T &v, StrictWeakOrdering comp)
+  {
+    return i < n && !comp(v, first[i]);
+  }
+};
+
+
+} // end namespace vectorized_search_detail
+
+
+// whether walking the merge of n elements and m sorted values, O(n + m) comparisons, costs
+// less than probing for each value, O(m log n); when it does not, sorted values are probed
+// too, so that the test for sortedness is only paid for when the walk may be taken
+template<typename IndexType>
+bool use_merge_search(IndexType n, IndexType m)
+{
+  const IndexType log_n = n < 2 ? IndexType(1) : thrust::detail::log2_ri(n);
+
+  return (n + m) / log_n < m;
+}
+
+
+// searches for each of values[begin, end) in [first, first + n) with an independent probe
+template<typename Search,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename IndexType,
+         typename StrictWeakOrdering>
+void probe_search(RandomAccessIterator1 first, IndexType n,
+                  RandomAccessIterator2 values,
+                  RandomAccessIterator3 output,
+                  IndexType begin, IndexType end,
+                  StrictWeakOrdering comp)
+{
+  for(IndexType j = begin; j < end; ++j)
+  {
+    typename thrust::iterator_value<RandomAccessIterator2>::type v = values[j];
+
+    const IndexType i = Search::probe(first, n, v, comp);
+
+    RandomAccessIterator3 tmp = output + j;
+    *tmp = Search::result(first, n, i, v, comp);
+  }
+}
+
+
+// searches for the sorted values[0, m) which fall between the diag_begin-th and diag_end-th
+// elements of their merge with [first, first + n) by walking both ranges together, so
+// tiles which partition the merge perform O(n + m) comparisons in total
+template<typename Search,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename IndexType,
+         typename StrictWeakOrdering>
+void merge_search(RandomAccessIterator1 first, IndexType n,
+                  RandomAccessIterator2 values, IndexType m,
+                  RandomAccessIterator3 output,
+                  IndexType diag_begin, IndexType diag_end,
+                  StrictWeakOrdering comp)
+{
+  const IndexType j_begin = Search::values_before(first, n, values, m, diag_begin, comp);
+  const IndexType j_end   = Search::values_before(first, n, values, m, diag_end,   comp);
+
+  // the elements of the range preceding the tile precede its first value
+  IndexType i = diag_begin - j_begin;
+
+  for(IndexType j = j_begin; j < j_end; ++j)
+  {
+    typename thrust::iterator_value<RandomAccessIterator2>::type v = values[j];
+
+    while(i < n && Search::precedes(first[i], v, comp))
+    {
+      ++i;
+    }
+
+    RandomAccessIterator3 tmp = output + j;
+    *tmp = Search::result(first, n, i, v, comp);
+  }
+}
+
+
+} // end namespace internal
+} // end namespace detail
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -36,6 +36,8 @@ namespace omp
 namespace detail
 {
 
+// rather than copying the whole input as generic::adjacent_difference does, only the
+// element preceding each tile is saved, after which the tiles may be written in place
 template<typename DerivedPolicy,
          typename InputIterator,
          typename OutputIterator,
@@ -44,14 +46,11 @@ template<typename DerivedPolicy,
                                      InputIterator first,
                                      InputIterator last,
                                      OutputIterator result,
-                                     BinaryFunction binary_op)
-{
-  // omp prefers generic::adjacent_difference to cpp::adjacent_difference
-  return thrust::system::detail::generic::adjacent_difference(exec, first, last, result, binary_op);
-} // end adjacent_difference()
+                                     BinaryFunction binary_op);
 
 } // end detail
 } // end omp
 } // end system
 THRUST_NAMESPACE_END
 
+#include <thrust/system/omp/detail/adjacent_difference.inl>
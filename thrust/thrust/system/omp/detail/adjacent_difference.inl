@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/adjacent_difference.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/adjacent_difference.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/adjacent_difference.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator adjacent_difference(execution_policy<DerivedPolicy> &exec,
+                                     InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result,
+                                     BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<InputIterator>::type      InputType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                  index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return result;
+  }
+  else if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::adjacent_difference(thrust::seq, first, last, result, binary_op);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // boundaries[i] is the element preceding tile i, saved before any tile is written
+  thrust::detail::temporary_array<InputType,DerivedPolicy> boundaries(exec, num_tiles);
+
+  for(index_type i = 1; i < num_tiles; ++i)
+  {
+    boundaries[i] = first[decomp[i].begin() - 1];
+  }
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  // the loop takes its schedule from exec
+  thrust::system::omp::detail::scoped_schedule schedule(exec);
+
+  // no tile of a nonempty range is empty
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) schedule(runtime))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    const difference_type begin = decomp[i].begin();
+
+    thrust::system::detail::internal::adjacent_difference_tile(first, begin, decomp[i].end(), result, binary_op);
+
+    // the first element of the tile is written last, after the tile has read it
+    OutputIterator out = result + begin;
+
+    if(i == 0)
+    {
+      *out = first[0];
+    }
+    else
+    {
+      const InputType before = boundaries[i];
+      *out = binary_op(thrust::raw_reference_cast(first[begin]), before);
+    }
+  }
+
+  return result + n;
+} // end adjacent_difference()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
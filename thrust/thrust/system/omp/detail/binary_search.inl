@@ -0,0 +1,177 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/binary_search.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/vectorized_search.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/sort.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+
+template<typename Search,
+         typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator vectorized_search(execution_policy<DerivedPolicy> &exec,
+                                 ForwardIterator begin,
+                                 ForwardIterator end,
+                                 InputIterator values_begin,
+                                 InputIterator values_end,
+                                 OutputIterator output,
+                                 StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      ForwardIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                    index_type;
+
+  const difference_type n = thrust::distance(begin, end);
+  const difference_type m = thrust::distance(values_begin, values_end);
+
+  // wrap comp
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  if(thrust::system::omp::detail::run_sequentially(exec, m))
+  {
+    thrust::system::detail::internal::probe_search<Search>(begin, n, values_begin, output, difference_type(0), m, wrapped_comp);
+
+    return output + m;
+  }
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  if(thrust::system::detail::internal::use_merge_search(n, m) && thrust::is_sorted(exec, values_begin, values_end, comp))
+  {
+    // one tile of the merge per thread
+    thrust::system::detail::internal::uniform_decomposition<difference_type> decomp(n + m, 1, threads);
+
+    const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+    THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+    for(index_type i = 0; i < num_tiles; ++i)
+    {
+      thrust::system::detail::internal::merge_search<Search>(begin, n, values_begin, m, output, decomp[i].begin(), decomp[i].end(), wrapped_comp);
+    }
+  }
+  else
+  {
+    thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, m);
+
+    const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+    THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+    for(index_type i = 0; i < num_tiles; ++i)
+    {
+      thrust::system::detail::internal::probe_search<Search>(begin, n, values_begin, output, decomp[i].begin(), decomp[i].end(), wrapped_comp);
+    }
+  }
+
+  return output + m;
+} // end vectorized_search()
+
+
+} // end namespace binary_search_detail
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  typedef thrust::system::detail::internal::vectorized_search_detail::lower_bound_search Search;
+
+  return binary_search_detail::vectorized_search<Search>(exec, begin, end, values_begin, values_end, output, comp);
+} // end lower_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  typedef thrust::system::detail::internal::vectorized_search_detail::upper_bound_search Search;
+
+  return binary_search_detail::vectorized_search<Search>(exec, begin, end, values_begin, values_end, output, comp);
+} // end upper_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+  typedef thrust::system::detail::internal::vectorized_search_detail::binary_search_search Search;
+
+  return binary_search_detail::vectorized_search<Search>(exec, begin, end, values_begin, values_end, output, comp);
+} // end binary_search()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -0,0 +1,427 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/compact.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/compact.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// every compaction proceeds in passes over the tiles of default_decomposition:
+//   1. each tile counts the elements it selects
+//   2. the counts are scanned sequentially into each tile's offset in the output
+//   3. each tile writes the elements it selects at its offset
+// so the only temporary storage is one count per tile
+// inputs below the sequential cutoff make the same selections in a single pass
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename Selector>
+  OutputIterator compact(execution_policy<DerivedPolicy> &exec,
+                         InputIterator first,
+                         InputIterator last,
+                         OutputIterator result,
+                         Selector select)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                  index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return result;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    for(difference_type j = 0; j < n; ++j)
+    {
+      if(select(j))
+      {
+        *result = first[j];
+        ++result;
+      }
+    }
+
+    return result;
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // offsets[i] is the position in the output of tile i
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  typename thrust::detail::temporary_array<difference_type,DerivedPolicy>::iterator offsets_first = offsets.begin();
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    difference_type count = 0;
+
+    for(difference_type j = decomp[i].begin(); j < decomp[i].end(); ++j)
+    {
+      if(select(j))
+      {
+        ++count;
+      }
+    }
+
+    offsets_first[i] = count;
+  }
+
+  offsets_first[num_tiles] = 0;
+
+  // offsets[num_tiles] becomes the size of the output
+  thrust::exclusive_scan(thrust::seq, offsets.begin(), offsets.end(), offsets.begin());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    OutputIterator out = result + offsets_first[i];
+
+    for(difference_type j = decomp[i].begin(); j < decomp[i].end(); ++j)
+    {
+      if(select(j))
+      {
+        *out = first[j];
+        ++out;
+      }
+    }
+  }
+
+  return result + offsets_first[num_tiles];
+} // end compact()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Selector>
+  RandomAccessIterator compact_in_place(execution_policy<DerivedPolicy> &exec,
+                                        RandomAccessIterator first,
+                                        RandomAccessIterator last,
+                                        Selector select)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      value_type;
+  typedef thrust::detail::intptr_t                                         index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return first;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return first + thrust::system::detail::internal::compact_range_in_place(first, difference_type(0), n, select);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // offsets[i] is the position in the output of tile i
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  typename thrust::detail::temporary_array<difference_type,DerivedPolicy>::iterator offsets_first = offsets.begin();
+
+  // each tile compacts itself to its own front
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    offsets_first[i] = thrust::system::detail::internal::compact_range_in_place(first, decomp[i].begin(), decomp[i].end(), select);
+  }
+
+  offsets_first[num_tiles] = 0;
+
+  // offsets[num_tiles] becomes the size of the output
+  thrust::exclusive_scan(thrust::seq, offsets.begin(), offsets.end(), offsets.begin());
+
+  // move the compacted tiles to their offsets through a scratch buffer
+  if(!thrust::system::detail::internal::compacted_tiles_in_place(decomp, offsets_first))
+  {
+    thrust::detail::temporary_array<value_type,DerivedPolicy> scratch(0, exec, thrust::system::detail::internal::compacted_scratch_size(decomp, offsets_first));
+
+    typename thrust::detail::temporary_array<value_type,DerivedPolicy>::iterator scratch_first = scratch.begin();
+
+    THRUST_PRAGMA_OMP(parallel num_threads(threads))
+    {
+      THRUST_PRAGMA_OMP(for)
+      for(index_type i = 1; i < num_tiles; ++i)
+      {
+        thrust::system::detail::internal::stash_compacted_tile(first, decomp, offsets_first, static_cast<difference_type>(i), scratch_first);
+      }
+
+      // the implicit barrier of the loop above separates the two steps
+
+      THRUST_PRAGMA_OMP(for)
+      for(index_type i = 1; i < num_tiles; ++i)
+      {
+        thrust::system::detail::internal::restore_compacted_tile(first, offsets_first, static_cast<difference_type>(i), scratch_first);
+      }
+    }
+  }
+
+  return first + offsets_first[num_tiles];
+} // end compact_in_place()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Selector>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    compact_partition(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      OutputIterator1 out_true,
+                      OutputIterator2 out_false,
+                      Selector select)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                  index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return thrust::make_pair(out_true, out_false);
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    for(difference_type j = 0; j < n; ++j)
+    {
+      if(select(j))
+      {
+        *out_true = first[j];
+        ++out_true;
+      }
+      else
+      {
+        *out_false = first[j];
+        ++out_false;
+      }
+    }
+
+    return thrust::make_pair(out_true, out_false);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // offsets[i] is the position in out_true of tile i;
+  // its position in out_false follows as the number of preceding elements not selected
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  typename thrust::detail::temporary_array<difference_type,DerivedPolicy>::iterator offsets_first = offsets.begin();
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    difference_type count = 0;
+
+    for(difference_type j = decomp[i].begin(); j < decomp[i].end(); ++j)
+    {
+      if(select(j))
+      {
+        ++count;
+      }
+    }
+
+    offsets_first[i] = count;
+  }
+
+  offsets_first[num_tiles] = 0;
+
+  // offsets[num_tiles] becomes the size of the true partition
+  thrust::exclusive_scan(thrust::seq, offsets.begin(), offsets.end(), offsets.begin());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    OutputIterator1 true_out  = out_true  + offsets_first[i];
+    OutputIterator2 false_out = out_false + (decomp[i].begin() - offsets_first[i]);
+
+    for(difference_type j = decomp[i].begin(); j < decomp[i].end(); ++j)
+    {
+      if(select(j))
+      {
+        *true_out = first[j];
+        ++true_out;
+      }
+      else
+      {
+        *false_out = first[j];
+        ++false_out;
+      }
+    }
+  }
+
+  return thrust::make_pair(out_true + offsets_first[num_tiles], out_false + (n - offsets_first[num_tiles]));
+} // end compact_partition()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Selector>
+  RandomAccessIterator1 compact_partition_in_place(execution_policy<DerivedPolicy> &exec,
+                                                   RandomAccessIterator1 first,
+                                                   RandomAccessIterator1 last,
+                                                   RandomAccessIterator2 buffer,
+                                                   Selector select)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+  typedef thrust::detail::intptr_t                                          index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return first;
+
+  // the first pass stages each tile in buffer, its selected elements in front of the others,
+  // and the second writes them back from buffer to their place in the partition
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return first + thrust::system::detail::internal::partition_range_in_place(first, buffer, n, select);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // offsets[i] is the position in the true partition of tile i;
+  // its position in the false partition follows as the number of preceding elements not selected
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  typename thrust::detail::temporary_array<difference_type,DerivedPolicy>::iterator offsets_first = offsets.begin();
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    offsets_first[i] = thrust::system::detail::internal::stage_partition_range(first, buffer, decomp[i].begin(), decomp[i].end(), select);
+  }
+
+  offsets_first[num_tiles] = 0;
+
+  // offsets[num_tiles] becomes the size of the true partition
+  thrust::exclusive_scan(thrust::seq, offsets.begin(), offsets.end(), offsets.begin());
+
+  const difference_type num_selected = offsets_first[num_tiles];
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    thrust::system::detail::internal::unstage_partition_range(buffer,
+                                                              decomp[i].begin(),
+                                                              decomp[i].end(),
+                                                              offsets_first[i + 1] - offsets_first[i],
+                                                              first + offsets_first[i],
+                                                              first + (num_selected + decomp[i].begin() - offsets_first[i]));
+  }
+
+  return first + num_selected;
+} // end compact_partition_in_place()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
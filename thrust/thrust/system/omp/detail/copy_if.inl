@@ -26,7 +26,7 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/copy_if.h>
-#include <thrust/system/detail/generic/copy_if.h>
+#include <thrust/system/omp/detail/compact.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -49,8 +49,9 @@ template<typename DerivedPolicy,
                          OutputIterator result,
                          Predicate pred)
 {
-  // omp prefers generic::copy_if to cpp::copy_if
-  return thrust::system::detail::generic::copy_if(exec, first, last, stencil, result, pred);
+  compact_detail::stencil_selector<InputIterator2,Predicate> select(stencil, pred);
+
+  return thrust::system::omp::detail::compact(exec, first, last, result, select);
 } // end copy_if()
 
 
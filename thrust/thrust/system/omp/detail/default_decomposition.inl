@@ -26,6 +26,8 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/detail/execution_policy.h>
 
 // don't attempt to #include this file without omp support
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
@@ -40,8 +42,8 @@ namespace omp
 namespace detail
 {
 
-template <typename IndexType>
-thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(IndexType n)
+template <typename DerivedPolicy, typename IndexType>
+thrust::system::detail::internal::uniform_decomposition<IndexType> default_decomposition(execution_policy<DerivedPolicy> &exec, IndexType n)
 {
   // we're attempting to launch an omp kernel, assert we're compiling with omp support
   // ========================================================================
@@ -55,6 +57,13 @@ thrust::system::detail::internal::uniform_decomposition<IndexType> default_decom
   , "OpenMP compiler support is not enabled"
   );
 
+  const int requested = get_num_threads(thrust::detail::derived_cast(exec));
+
+  if(requested > 0)
+  {
+    return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, requested);
+  }
+
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   return thrust::system::detail::internal::uniform_decomposition<IndexType>(n, 1, omp_get_num_procs());
 #else
@@ -41,18 +41,17 @@ namespace omp
 namespace detail
 {
 
+// threads claim blocks of the range in order and skip those beyond the first match found
+// so far; generic::mismatch, equal, all_of, any_of, none_of and is_sorted_until build on it
 template <typename DerivedPolicy, typename InputIterator, typename Predicate>
 InputIterator find_if(execution_policy<DerivedPolicy> &exec,
                       InputIterator first,
                       InputIterator last,
-                      Predicate pred)
-{
-  // omp prefers generic::find_if to cpp::find_if
-  return thrust::system::detail::generic::find_if(exec, first, last, pred);
-}
+                      Predicate pred);
 
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
 THRUST_NAMESPACE_END
 
+#include <thrust/system/omp/detail/find.inl>
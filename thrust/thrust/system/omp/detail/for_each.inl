@@ -27,9 +27,11 @@
 #endif // no system header
 #include <thrust/detail/function.h>
 #include <thrust/detail/static_assert.h>
+#include <thrust/detail/seq.h>
 #include <thrust/distance.h>
 #include <thrust/for_each.h>
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/system/omp/detail/parallelism.h>
 #include <thrust/system/omp/detail/pragma_omp.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -44,7 +46,7 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
@@ -63,6 +65,11 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
 
   if (n <= 0) return first;  //empty range
 
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::for_each_n(thrust::seq, first, n, f);
+  }
+
   // create a wrapped function for f
   thrust::detail::wrapped_function<UnaryFunction,void> wrapped_f(f);
 
@@ -70,7 +77,12 @@ RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type DifferenceType;
   DifferenceType signed_n = n;
 
-  THRUST_PRAGMA_OMP(parallel for)
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  // the loop takes its schedule from exec
+  thrust::system::omp::detail::scoped_schedule schedule(exec);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) schedule(runtime))
   for(DifferenceType i = 0;
       i < signed_n;
       ++i)
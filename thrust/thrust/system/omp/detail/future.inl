@@ -0,0 +1,248 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp14_required.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <thrust/system/omp/future.h>
+#include <thrust/system/detail/internal/eager_future.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace omp
+{
+
+namespace detail
+{
+
+
+// OpenMP only defers tasks inside a parallel region, so the tasks run on a pool of
+// threads of their own, each of which opens the parallel regions of its algorithm.
+// the pool has one thread per hardware thread and starts the tasks in the order they
+// were launched. a task only waits for the events and futures of tasks launched
+// before it, so the earliest task still running never waits, and a full pool of
+// waiting tasks cannot keep its dependencies from running
+class async_pool
+{
+public:
+  explicit async_pool(unsigned int num_threads)
+    : stop_(false)
+  {
+    for (unsigned int i = 0; i < num_threads; ++i)
+    {
+      threads_.emplace_back([this] { run(); });
+    }
+  }
+
+  // the tasks launched before exit are completed first
+  ~async_pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+
+    ready_.notify_all();
+
+    for (std::thread& t : threads_)
+    {
+      t.join();
+    }
+  }
+
+  static async_pool& instance()
+  {
+    static async_pool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+  }
+
+  void push(std::function<void()> job)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(std::move(job));
+    }
+
+    ready_.notify_one();
+  }
+
+private:
+  void run()
+  {
+    for (;;)
+    {
+      std::function<void()> job;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+
+        if (jobs_.empty()) return;
+
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+
+      job();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::function<void()>> jobs_;
+  bool stop_;
+  std::vector<std::thread> threads_;
+};
+
+
+// the state shared by a signal and its task in the pool, which may outlive the signal
+// while it notifies
+struct async_state
+{
+  async_state() : done(false) {}
+
+  std::mutex mutex;
+  std::condition_variable completed;
+  bool done;
+  std::exception_ptr error;
+};
+
+
+class async_signal : public thrust::system::detail::internal::eager_signal
+{
+public:
+  template <typename Task>
+  explicit async_signal(Task task)
+    : state_(std::make_shared<async_state>())
+  {
+    std::shared_ptr<async_state> state = state_;
+
+    async_pool::instance().push([state, task] () mutable
+    {
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        state->error = std::current_exception();
+      }
+
+      // the work and the dependencies are released before the task is complete
+      task = Task();
+
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done = true;
+      }
+
+      state->completed.notify_all();
+    });
+  }
+
+  // the task catches its exceptions, so waiting for it does not throw
+  ~async_signal() noexcept
+  {
+    block();
+  }
+
+  bool ready() const
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->done;
+  }
+
+  // the exception of the task is rethrown by every call
+  void wait()
+  {
+    block();
+
+    if (state_->error) std::rethrow_exception(state_->error);
+  }
+
+private:
+  void block()
+  {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->completed.wait(lock, [this] { return state_->done; });
+  }
+
+  std::shared_ptr<async_state> state_;
+};
+
+
+struct launch_async
+{
+  typedef tag system_tag;
+
+  template <typename Task>
+  std::unique_ptr<thrust::system::detail::internal::eager_signal>
+  operator()(Task task) const
+  {
+    return std::unique_ptr<thrust::system::detail::internal::eager_signal>(new async_signal(task));
+  }
+};
+
+
+// the launch hook of the asynchronous algorithms in system/detail/internal/async
+template <typename DerivedPolicy>
+_CCCL_HOST
+launch_async eager_launch(execution_policy<DerivedPolicy>&)
+{
+  return launch_async();
+}
+
+
+} // namespace detail
+
+template <typename... Events>
+_CCCL_HOST
+unique_eager_event when_all(Events&&... evs)
+{
+  return thrust::system::detail::internal::make_joined_event<tag>(
+    std::make_tuple(std::move(evs)...)
+  );
+}
+
+}} // namespace system::omp
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
+
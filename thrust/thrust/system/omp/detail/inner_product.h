@@ -14,6 +14,11 @@
  *  limitations under the License.
  */
 
+
+/*! \file inner_product.h
+ *  \brief OpenMP implementation of inner_product.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
@@ -25,7 +30,35 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/system/omp/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// each tile reduces the products of the two inputs in a plain loop over both
+// rather than through a zip_iterator, so arithmetic on contiguous inputs vectorizes
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputType,
+         typename BinaryFunction1,
+         typename BinaryFunction2>
+  OutputType inner_product(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           OutputType init,
+                           BinaryFunction1 binary_op1,
+                           BinaryFunction2 binary_op2);
 
-// this system inherits inner_product
-#include <thrust/system/cpp/detail/inner_product.h>
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
 
+#include <thrust/system/omp/detail/inner_product.inl>
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/inner_product.h>
+#include <thrust/system/omp/detail/transform_reduce.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/detail/internal/transform_reduce.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/inner_product.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputType,
+         typename BinaryFunction1,
+         typename BinaryFunction2>
+  OutputType inner_product(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           OutputType init,
+                           BinaryFunction1 binary_op1,
+                           BinaryFunction2 binary_op2)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if(n == 0)
+  {
+    return init;
+  }
+  else if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::inner_product(thrust::seq, first1, last1, first2, init, binary_op1, binary_op2);
+  }
+
+  // wrap binary_op2
+  thrust::detail::wrapped_function<BinaryFunction2,OutputType> wrapped_binary_op2(binary_op2);
+
+  typedef thrust::system::detail::internal::inner_product_at<
+    InputIterator1,
+    InputIterator2,
+    thrust::detail::wrapped_function<BinaryFunction2,OutputType>,
+    OutputType
+  > IndexFunction;
+
+  return transform_reduce_detail::reduce_indices(exec, n, IndexFunction(first1, first2, wrapped_binary_op2), init, binary_op1);
+} // end inner_product()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
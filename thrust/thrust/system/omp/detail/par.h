@@ -26,26 +26,163 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/detail/allocator_aware_execution_policy.h>
+#if _CCCL_STD_VER >= 2011
+#  include <thrust/detail/dependencies_aware_execution_policy.h>
+#endif
 #include <thrust/system/omp/detail/execution_policy.h>
 
+#include <cstddef>
+
+// algorithms given fewer elements than this run sequentially rather than pay
+// for a parallel region; par.sequential_cutoff() overrides it per call
+#ifndef THRUST_OMP_SEQUENTIAL_CUTOFF
+#define THRUST_OMP_SEQUENTIAL_CUTOFF 4096
+#endif
+
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
 namespace omp
 {
+
+
+// the loop schedules which may be requested with par.schedule()
+enum schedule_kind
+{
+  schedule_static,
+  schedule_dynamic,
+  schedule_guided
+};
+
+
 namespace detail
 {
 
 
+struct loop_schedule
+{
+  schedule_kind kind;
+
+  // a chunk size of zero selects the default chunk size of kind
+  int chunk;
+
+  _CCCL_HOST_DEVICE
+  loop_schedule(schedule_kind kind_ = schedule_static, int chunk_ = 0)
+    : kind(kind_), chunk(chunk_)
+  {}
+};
+
+
+template<typename Derived>
+struct execute_with_parallelism_base : thrust::system::omp::detail::execution_policy<Derived>
+{
+private:
+  // zero threads selects the OpenMP default
+  int num_threads_;
+  loop_schedule schedule_;
+
+  // a negative cutoff selects THRUST_OMP_SEQUENTIAL_CUTOFF
+  std::ptrdiff_t sequential_cutoff_;
+
+public:
+  _CCCL_HOST_DEVICE
+  execute_with_parallelism_base()
+    : num_threads_(0), schedule_(), sequential_cutoff_(-1)
+  {}
+
+  Derived num_threads(int n) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.num_threads_ = n;
+    return result;
+  }
+
+  Derived schedule(schedule_kind kind, int chunk = 0) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.schedule_ = loop_schedule(kind, chunk);
+    return result;
+  }
+
+  Derived sequential_cutoff(std::ptrdiff_t n) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.sequential_cutoff_ = n;
+    return result;
+  }
+
+private:
+  friend int get_num_threads(const execute_with_parallelism_base &exec)
+  {
+    return exec.num_threads_;
+  }
+
+  friend loop_schedule get_schedule(const execute_with_parallelism_base &exec)
+  {
+    return exec.schedule_;
+  }
+
+  friend std::ptrdiff_t get_sequential_cutoff(const execute_with_parallelism_base &exec)
+  {
+    return exec.sequential_cutoff_;
+  }
+};
+
+
+struct execute_with_parallelism : execute_with_parallelism_base<execute_with_parallelism>
+{};
+
+
 struct par_t : thrust::system::omp::detail::execution_policy<par_t>,
   thrust::detail::allocator_aware_execution_policy<
-    thrust::system::omp::detail::execution_policy>
+    execute_with_parallelism_base>
+#if _CCCL_STD_VER >= 2011
+, thrust::detail::dependencies_aware_execution_policy<
+    execute_with_parallelism_base>
+#endif
 {
   _CCCL_HOST_DEVICE
   constexpr par_t() : thrust::system::omp::detail::execution_policy<par_t>() {}
+
+  execute_with_parallelism num_threads(int n) const
+  {
+    return execute_with_parallelism().num_threads(n);
+  }
+
+  execute_with_parallelism schedule(schedule_kind kind, int chunk = 0) const
+  {
+    return execute_with_parallelism().schedule(kind, chunk);
+  }
+
+  execute_with_parallelism sequential_cutoff(std::ptrdiff_t n) const
+  {
+    return execute_with_parallelism().sequential_cutoff(n);
+  }
 };
 
 
+// policies other than those built from par run with the OpenMP defaults
+template<typename DerivedPolicy>
+int get_num_threads(execution_policy<DerivedPolicy> &)
+{
+  return 0;
+}
+
+
+template<typename DerivedPolicy>
+loop_schedule get_schedule(execution_policy<DerivedPolicy> &)
+{
+  return loop_schedule();
+}
+
+
+template<typename DerivedPolicy>
+std::ptrdiff_t get_sequential_cutoff(execution_policy<DerivedPolicy> &)
+{
+  return -1;
+}
+
+
 } // end detail
 
 
@@ -62,6 +199,10 @@ namespace omp
 
 
 using thrust::system::omp::par;
+using thrust::system::omp::schedule_kind;
+using thrust::system::omp::schedule_static;
+using thrust::system::omp::schedule_dynamic;
+using thrust::system::omp::schedule_guided;
 
 
 } // end omp
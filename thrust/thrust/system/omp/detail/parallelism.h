@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file parallelism.h
+ *  \brief The number of threads, the loop schedule and the sequential cutoff
+ *         with which the OpenMP system executes a policy.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/execution_policy.h>
+#include <thrust/system/omp/detail/par.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// returns the number of threads of the parallel regions executing exec:
+// the number requested with par.num_threads(), or else the OpenMP default
+template<typename DerivedPolicy>
+int num_threads(execution_policy<DerivedPolicy> &exec);
+
+
+// returns true when exec should process n elements sequentially: n is below
+// the cutoff requested with par.sequential_cutoff(), or else THRUST_OMP_SEQUENTIAL_CUTOFF
+template<typename DerivedPolicy, typename Size>
+bool run_sequentially(execution_policy<DerivedPolicy> &exec, Size n);
+
+
+// applies the loop schedule requested with par.schedule() to the schedule(runtime)
+// loops encountered by the calling thread during its lifetime
+class scoped_schedule
+{
+  public:
+    template<typename DerivedPolicy>
+    explicit scoped_schedule(execution_policy<DerivedPolicy> &exec);
+
+    ~scoped_schedule();
+
+  private:
+    // the schedule in effect before construction
+    int saved_kind;
+    int saved_chunk;
+
+    // disallow copying
+    scoped_schedule(const scoped_schedule &);
+    scoped_schedule &operator=(const scoped_schedule &);
+};
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/omp/detail/parallelism.inl>
+
@@ -0,0 +1,116 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/detail/execution_policy.h>
+
+#include <cstddef>
+
+// don't attempt to #include this file without omp support
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+#include <omp.h>
+#endif // omp support
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy>
+int num_threads(execution_policy<DerivedPolicy> &exec)
+{
+  const int requested = get_num_threads(thrust::detail::derived_cast(exec));
+
+  if(requested > 0)
+  {
+    return requested;
+  }
+
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+} // end num_threads()
+
+
+template<typename DerivedPolicy, typename Size>
+bool run_sequentially(execution_policy<DerivedPolicy> &exec, Size n)
+{
+  std::ptrdiff_t cutoff = get_sequential_cutoff(thrust::detail::derived_cast(exec));
+
+  if(cutoff < 0)
+  {
+    cutoff = THRUST_OMP_SEQUENTIAL_CUTOFF;
+  }
+
+  return static_cast<std::ptrdiff_t>(n) < cutoff;
+} // end run_sequentially()
+
+
+template<typename DerivedPolicy>
+scoped_schedule::scoped_schedule(execution_policy<DerivedPolicy> &exec)
+  : saved_kind(0), saved_chunk(0)
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  omp_sched_t kind;
+  omp_get_schedule(&kind, &saved_chunk);
+  saved_kind = static_cast<int>(kind);
+
+  const loop_schedule requested = get_schedule(thrust::detail::derived_cast(exec));
+
+  switch(requested.kind)
+  {
+    case schedule_dynamic: kind = omp_sched_dynamic; break;
+    case schedule_guided:  kind = omp_sched_guided;  break;
+    default:               kind = omp_sched_static;  break;
+  }
+
+  omp_set_schedule(kind, requested.chunk);
+#else
+  (void) exec;
+#endif
+} // end scoped_schedule::scoped_schedule()
+
+
+inline scoped_schedule::~scoped_schedule()
+{
+#if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+  omp_set_schedule(static_cast<omp_sched_t>(saved_kind), saved_chunk);
+#endif
+} // end scoped_schedule::~scoped_schedule()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -31,7 +31,10 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/partition.h>
-#include <thrust/system/detail/generic/partition.h>
+#include <thrust/system/omp/detail/compact.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -50,8 +53,16 @@ template<typename DerivedPolicy,
                                    ForwardIterator last,
                                    Predicate pred)
 {
-  // omp prefers generic::stable_partition to cpp::stable_partition
-  return thrust::system::detail::generic::stable_partition(exec, first, last, pred);
+  typedef typename thrust::iterator_value<ForwardIterator>::type InputType;
+  typedef thrust::detail::temporary_array<InputType,DerivedPolicy> Buffer;
+
+  // the buffer comes from exec, so an allocator given to par(alloc) may recycle it across calls;
+  // it is left uninitialized, and the partition constructs each element as it stages it
+  Buffer buffer(0, exec, thrust::distance(first, last));
+
+  compact_detail::stencil_selector<ForwardIterator,Predicate> select(first, pred);
+
+  return thrust::system::omp::detail::compact_partition_in_place(exec, first, last, buffer.begin(), select);
 } // end stable_partition()
 
 
@@ -65,8 +76,14 @@ template<typename DerivedPolicy,
                                    InputIterator stencil,
                                    Predicate pred)
 {
-  // omp prefers generic::stable_partition to cpp::stable_partition
-  return thrust::system::detail::generic::stable_partition(exec, first, last, stencil, pred);
+  typedef typename thrust::iterator_value<ForwardIterator>::type InputType;
+  typedef thrust::detail::temporary_array<InputType,DerivedPolicy> Buffer;
+
+  Buffer buffer(0, exec, thrust::distance(first, last));
+
+  compact_detail::stencil_selector<InputIterator,Predicate> select(stencil, pred);
+
+  return thrust::system::omp::detail::compact_partition_in_place(exec, first, last, buffer.begin(), select);
 } // end stable_partition()
 
 
@@ -83,8 +100,9 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, out_true, out_false, pred);
+  compact_detail::stencil_selector<InputIterator,Predicate> select(first, pred);
+
+  return thrust::system::omp::detail::compact_partition(exec, first, last, out_true, out_false, select);
 } // end stable_partition_copy()
 
 
@@ -103,8 +121,9 @@ template<typename DerivedPolicy,
                           OutputIterator2 out_false,
                           Predicate pred)
 {
-  // omp prefers generic::stable_partition_copy to cpp::stable_partition_copy
-  return thrust::system::detail::generic::stable_partition_copy(exec, first, last, stencil, out_true, out_false, pred);
+  compact_detail::stencil_selector<InputIterator2,Predicate> select(stencil, pred);
+
+  return thrust::system::omp::detail::compact_partition(exec, first, last, out_true, out_false, select);
 } // end stable_partition_copy()
 
 
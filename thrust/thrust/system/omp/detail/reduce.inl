@@ -29,6 +29,9 @@
 #include <thrust/system/omp/detail/reduce.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
 #include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/detail/seq.h>
+#include <thrust/reduce.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -53,8 +56,13 @@ template<typename DerivedPolicy,
 
   const difference_type n = thrust::distance(first,last);
 
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::reduce(thrust::seq, first, last, init, binary_op);
+  }
+
   // determine first and second level decomposition
-  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1 = thrust::system::omp::detail::default_decomposition(n);
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp1 = thrust::system::omp::detail::default_decomposition(exec, n);
   thrust::system::detail::internal::uniform_decomposition<difference_type> decomp2(decomp1.size() + 1, 1, 1);
 
   // allocate storage for the initializer and partial sums
@@ -26,8 +26,18 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/reduce_by_key.h>
-#include <thrust/system/detail/generic/reduce_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -37,6 +47,18 @@ namespace omp
 namespace detail
 {
 
+
+// reduce_by_key proceeds in passes over the tiles of default_decomposition:
+//   1. each tile counts the runs of equivalent keys which end within it, and reduces
+//      the run it leaves unfinished, if any, into its carry
+//   2. the counts are scanned into each tile's offset in the output, and the carries are
+//      threaded through the tiles, both sequentially
+//   3. each tile reduces its runs, seeded with the carry of the previous tile when it
+//      continues a run, and writes those which end within it at its offset
+// so the temporary storage is one count and one carry per tile, and the output is
+// written exactly once
+
+
 template <typename DerivedPolicy,
           typename InputIterator1,
           typename InputIterator2,
@@ -54,8 +76,163 @@ template <typename DerivedPolicy,
                   BinaryPredicate binary_pred,
                   BinaryFunction binary_op)
 {
-  // omp prefers generic::reduce_by_key to cpp::reduce_by_key
-  return thrust::system::detail::generic::reduce_by_key(exec, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<InputIterator1>::type      KeyType;
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator2>::type      ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::detail::intptr_t                                   index_type;
+
+  const difference_type n = thrust::distance(keys_first, keys_last);
+
+  if(n == 0) return thrust::make_pair(keys_output, values_output);
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::reduce_by_key(thrust::seq, keys_first, keys_last, values_first, keys_output, values_output, binary_pred, binary_op);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  // offsets[i] is the position in the output of the first run ending in tile i
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  // the head key and partial reduction of the run left unfinished by each tile
+  thrust::detail::temporary_array<KeyType,DerivedPolicy>   carry_keys(exec, decomp.size());
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carry_values(exec, decomp.size());
+
+  typename thrust::detail::temporary_array<difference_type,DerivedPolicy>::iterator offsets_first      = offsets.begin();
+  typename thrust::detail::temporary_array<KeyType,DerivedPolicy>::iterator         carry_keys_first   = carry_keys.begin();
+  typename thrust::detail::temporary_array<ValueType,DerivedPolicy>::iterator       carry_values_first = carry_values.begin();
+
+  // wrap binary_pred & binary_op
+  thrust::detail::wrapped_function<BinaryPredicate,bool>     wrapped_binary_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // count the last elements of runs; the last element of the input always ends a run
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    difference_type count = 0;
+
+    for(difference_type j = decomp[i].begin(); j < decomp[i].end(); ++j)
+    {
+      if(j + 1 == n || !wrapped_binary_pred(keys_first[j], keys_first[j + 1]))
+      {
+        ++count;
+      }
+    }
+
+    offsets_first[i] = count;
+
+    const difference_type last = decomp[i].end() - 1;
+
+    // reduce the run left unfinished by this tile, which begins after the tile's last run
+    if(last + 1 < n && wrapped_binary_pred(keys_first[last], keys_first[last + 1]))
+    {
+      difference_type j = last;
+
+      while(j > decomp[i].begin() && wrapped_binary_pred(keys_first[j - 1], keys_first[j]))
+      {
+        --j;
+      }
+
+      carry_keys_first[i] = keys_first[j];
+
+      ValueType value = values_first[j];
+
+      for(++j; j <= last; ++j)
+      {
+        value = wrapped_binary_op(value, values_first[j]);
+      }
+
+      carry_values_first[i] = value;
+    }
+  }
+
+  offsets_first[num_tiles] = 0;
+
+  // offsets[num_tiles] becomes the size of the output
+  thrust::exclusive_scan(thrust::seq, offsets.begin(), offsets.end(), offsets.begin());
+
+  // a tile in which no run ends extends the carry of the previous tile, if it continues its run
+  // the last tile always ends a run, so it never extends a carry
+  for(index_type i = 1; i + 1 < num_tiles; ++i)
+  {
+    const difference_type j = decomp[i].begin();
+
+    if(offsets_first[i + 1] == offsets_first[i] && wrapped_binary_pred(keys_first[j - 1], keys_first[j]))
+    {
+      carry_keys_first[i]   = carry_keys_first[i - 1];
+      carry_values_first[i] = wrapped_binary_op(carry_values_first[i - 1], carry_values_first[i]);
+    }
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    // a tile in which no run ends has no output
+    if(offsets_first[i + 1] == offsets_first[i]) continue;
+
+    OutputIterator1 keys_out   = keys_output   + offsets_first[i];
+    OutputIterator2 values_out = values_output + offsets_first[i];
+
+    difference_type j = decomp[i].begin();
+
+    KeyType   key   = keys_first[j];
+    ValueType value = values_first[j];
+
+    // continue the run left unfinished by the previous tile
+    if(j > 0 && wrapped_binary_pred(keys_first[j - 1], keys_first[j]))
+    {
+      key   = carry_keys_first[i - 1];
+      value = wrapped_binary_op(carry_values_first[i - 1], values_first[j]);
+    }
+
+    for(;;)
+    {
+      const bool is_tail = (j + 1 == n) || !wrapped_binary_pred(keys_first[j], keys_first[j + 1]);
+
+      if(is_tail)
+      {
+        *keys_out   = key;
+        *values_out = value;
+
+        ++keys_out;
+        ++values_out;
+      }
+
+      // the elements after the tile's last run belong to its carry
+      if(++j == decomp[i].end()) break;
+
+      if(is_tail)
+      {
+        key   = keys_first[j];
+        value = values_first[j];
+      }
+      else
+      {
+        value = wrapped_binary_op(value, values_first[j]);
+      }
+    }
+  }
+
+  return thrust::make_pair(keys_output + offsets_first[num_tiles], values_output + offsets_first[num_tiles]);
 } // end reduce_by_key()
 
 
@@ -26,6 +26,9 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/transform_reduce.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
 #include <thrust/detail/cstdint.h>
@@ -43,7 +46,7 @@ template <typename DerivedPolicy,
           typename OutputIterator,
           typename BinaryFunction,
           typename Decomposition>
-void reduce_intervals(execution_policy<DerivedPolicy> &,
+void reduce_intervals(execution_policy<DerivedPolicy> &exec,
                       InputIterator input,
                       OutputIterator output,
                       BinaryFunction binary_op,
@@ -69,28 +72,22 @@ void reduce_intervals(execution_policy<DerivedPolicy> &,
 
   typedef thrust::detail::intptr_t index_type;
 
+  typedef thrust::system::detail::internal::element_at<InputIterator,OutputType> element_at;
+
   index_type n = static_cast<index_type>(decomp.size());
 
-  THRUST_PRAGMA_OMP(parallel for)
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  // the loop takes its schedule from exec
+  thrust::system::omp::detail::scoped_schedule schedule(exec);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) schedule(runtime))
   for(index_type i = 0; i < n; i++)
   {
-    InputIterator begin = input + decomp[i].begin();
-    InputIterator end   = input + decomp[i].end();
-
-    if (begin != end)
+    if (decomp[i].begin() != decomp[i].end())
     {
-      OutputType sum = thrust::raw_reference_cast(*begin);
-
-      ++begin;
-
-      while (begin != end)
-      {
-        sum = wrapped_binary_op(sum, *begin);
-        ++begin;
-      }
-
       OutputIterator tmp = output + i;
-      *tmp = sum;
+      *tmp = thrust::system::detail::internal::reduce_tile<OutputType>(decomp[i].begin(), decomp[i].end(), element_at(input), wrapped_binary_op);
     }
   }
 #endif // THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE
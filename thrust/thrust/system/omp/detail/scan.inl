@@ -0,0 +1,217 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/scan.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// both scans are implemented as a reduce-then-scan over the tiles of
+// default_decomposition:
+//   1. every tile is reduced independently (reduce_intervals)
+//   2. the tile sums are scanned sequentially to produce each tile's carry
+//   3. every tile is scanned independently, seeded with its carry
+// the input is read completely in step 1 before step 3 writes any tile,
+// and each tile is only ever written by the thread which reads it in step 3,
+// so in-situ scans (result == first) remain valid
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  // Use the input iterator's value type per https://wg21.link/P0571
+  typedef typename thrust::iterator_value<InputIterator>::type      ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                  index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return result;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::inclusive_scan(thrust::seq, first, last, result, binary_op);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  // reduce each tile
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, decomp.size());
+  thrust::system::omp::detail::reduce_intervals(exec, first, carries.begin(), binary_op, decomp);
+
+  // carries[i] becomes the sum of tiles [0, i]
+  thrust::inclusive_scan(thrust::seq, carries.begin(), carries.end(), carries.begin(), binary_op);
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typename thrust::detail::temporary_array<ValueType,DerivedPolicy>::iterator carries_first = carries.begin();
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator  iter1 = first  + decomp[i].begin();
+    InputIterator  last1 = first  + decomp[i].end();
+    OutputIterator iter2 = result + decomp[i].begin();
+
+    // the first tile has no carry
+    ValueType sum = (i == 0) ? ValueType(*iter1) : wrapped_binary_op(carries_first[i - 1], *iter1);
+    *iter2 = sum;
+
+    for(++iter1, ++iter2; iter1 != last1; ++iter1, ++iter2)
+    {
+      *iter2 = sum = wrapped_binary_op(sum, *iter1);
+    }
+  }
+
+  return result + n;
+} // end inclusive_scan()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename InitialValueType,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
+                                InputIterator first,
+                                InputIterator last,
+                                OutputIterator result,
+                                InitialValueType init,
+                                BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  // Use the initial value type per https://wg21.link/P0571
+  typedef InitialValueType                                          ValueType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                  index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return result;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::exclusive_scan(thrust::seq, first, last, result, init, binary_op);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  // reduce each tile
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, decomp.size());
+  thrust::system::omp::detail::reduce_intervals(exec, first, carries.begin(), binary_op, decomp);
+
+  // carries[i] becomes the sum of init and tiles [0, i)
+  thrust::exclusive_scan(thrust::seq, carries.begin(), carries.end(), carries.begin(), init, binary_op);
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  typename thrust::detail::temporary_array<ValueType,DerivedPolicy>::iterator carries_first = carries.begin();
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator  iter1 = first  + decomp[i].begin();
+    InputIterator  last1 = first  + decomp[i].end();
+    OutputIterator iter2 = result + decomp[i].begin();
+
+    ValueType sum = carries_first[i];
+
+    for(; iter1 != last1; ++iter1, ++iter2)
+    {
+      ValueType tmp = *iter1; // temporary value allows in-situ scan
+      *iter2 = sum;
+      sum = wrapped_binary_op(sum, tmp);
+    }
+  }
+
+  return result + n;
+} // end exclusive_scan()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,360 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/scan_by_key.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// both segmented scans follow the three phases of omp::detail::inclusive_scan
+// over the tiles of default_decomposition. the summary of a tile is the pair
+// (head, sum) where head records whether a segment begins inside the tile and
+// sum is the sum of the tile's last, possibly unfinished, segment. summaries
+// combine like the segmented scan operator:
+//
+//   (head1, sum1) + (head2, sum2) = (head1 || head2, head2 ? sum2 : sum1 + sum2)
+//
+// so scanning the summaries yields the carry into each tile, and a tile whose
+// first key begins a new segment simply ignores its carry
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<InputIterator1>::type      KeyType;
+  typedef typename thrust::iterator_value<InputIterator2>::type      ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::detail::intptr_t                                   index_type;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if(n == 0) return result;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::inclusive_scan_by_key(thrust::seq, first1, last1, first2, result, binary_pred, binary_op);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      heads(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      leading_heads(exec, num_tiles);
+
+  typename thrust::detail::temporary_array<ValueType,DerivedPolicy>::iterator carries_first       = carries.begin();
+  typename thrust::detail::temporary_array<bool,DerivedPolicy>::iterator      heads_first         = heads.begin();
+  typename thrust::detail::temporary_array<bool,DerivedPolicy>::iterator      leading_heads_first = leading_heads.begin();
+
+  // wrap binary_pred & binary_op
+  thrust::detail::wrapped_function<BinaryPredicate,bool>     wrapped_binary_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // summarize each tile
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator1 keys      = first1 + decomp[i].begin();
+    InputIterator1 keys_last = first1 + decomp[i].end();
+    InputIterator2 values    = first2 + decomp[i].begin();
+
+    // the first tile always begins a segment
+    // record whether the tile's first key begins a segment before any output is
+    // written, as the output may alias the keys
+    bool head = (i == 0) || !wrapped_binary_pred(*(keys - 1), *keys);
+
+    leading_heads_first[i] = head;
+
+    KeyType   prev_key = *keys;
+    ValueType sum      = *values;
+
+    for(++keys, ++values; keys != keys_last; ++keys, ++values)
+    {
+      KeyType key = *keys;
+
+      if(wrapped_binary_pred(prev_key, key))
+      {
+        sum = wrapped_binary_op(sum, *values);
+      }
+      else
+      {
+        sum  = *values;
+        head = true;
+      }
+
+      prev_key = key;
+    }
+
+    carries_first[i] = sum;
+    heads_first[i]   = head;
+  }
+
+  // carries[i] becomes the sum of the segment which is open at the end of tile i
+  for(index_type i = 1; i < num_tiles; ++i)
+  {
+    if(!heads_first[i])
+    {
+      carries_first[i] = wrapped_binary_op(carries_first[i - 1], carries_first[i]);
+    }
+  }
+
+  // scan each tile
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator1 keys      = first1 + decomp[i].begin();
+    InputIterator1 keys_last = first1 + decomp[i].end();
+    InputIterator2 values    = first2 + decomp[i].begin();
+    OutputIterator output    = result + decomp[i].begin();
+
+    const bool head = leading_heads_first[i];
+
+    KeyType   prev_key = *keys;
+    ValueType sum      = head ? ValueType(*values) : wrapped_binary_op(carries_first[i - 1], *values);
+
+    *output = sum;
+
+    for(++keys, ++values, ++output; keys != keys_last; ++keys, ++values, ++output)
+    {
+      KeyType key = *keys;
+
+      if(wrapped_binary_pred(prev_key, key))
+        *output = sum = wrapped_binary_op(sum, *values);
+      else
+        *output = sum = *values;
+
+      prev_key = key;
+    }
+  }
+
+  return result + n;
+} // end inclusive_scan_by_key()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      InputIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<InputIterator1>::type      KeyType;
+  typedef T                                                          ValueType;
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+  typedef thrust::detail::intptr_t                                   index_type;
+
+  const difference_type n = thrust::distance(first1, last1);
+
+  if(n == 0) return result;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::exclusive_scan_by_key(thrust::seq, first1, last1, first2, result, init, binary_pred, binary_op);
+  }
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  thrust::detail::temporary_array<ValueType,DerivedPolicy> carries(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      heads(exec, num_tiles);
+  thrust::detail::temporary_array<bool,DerivedPolicy>      leading_heads(exec, num_tiles);
+
+  typename thrust::detail::temporary_array<ValueType,DerivedPolicy>::iterator carries_first       = carries.begin();
+  typename thrust::detail::temporary_array<bool,DerivedPolicy>::iterator      heads_first         = heads.begin();
+  typename thrust::detail::temporary_array<bool,DerivedPolicy>::iterator      leading_heads_first = leading_heads.begin();
+
+  // wrap binary_pred & binary_op
+  thrust::detail::wrapped_function<BinaryPredicate,bool>     wrapped_binary_pred(binary_pred);
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> wrapped_binary_op(binary_op);
+
+  // summarize each tile
+  // a segment which begins inside a tile is seeded with init
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator1 keys      = first1 + decomp[i].begin();
+    InputIterator1 keys_last = first1 + decomp[i].end();
+    InputIterator2 values    = first2 + decomp[i].begin();
+
+    // the first tile always begins a segment
+    // record whether the tile's first key begins a segment before any output is
+    // written, as the output may alias the keys
+    bool head = (i == 0) || !wrapped_binary_pred(*(keys - 1), *keys);
+
+    leading_heads_first[i] = head;
+
+    KeyType   prev_key = *keys;
+    ValueType value    = *values;
+    ValueType sum      = head ? wrapped_binary_op(init, value) : value;
+
+    for(++keys, ++values; keys != keys_last; ++keys, ++values)
+    {
+      KeyType key = *keys;
+
+      value = *values;
+
+      if(wrapped_binary_pred(prev_key, key))
+      {
+        sum = wrapped_binary_op(sum, value);
+      }
+      else
+      {
+        sum  = wrapped_binary_op(init, value);
+        head = true;
+      }
+
+      prev_key = key;
+    }
+
+    carries_first[i] = sum;
+    heads_first[i]   = head;
+  }
+
+  // carries[i] becomes the sum of the segment which is open at the end of tile i
+  for(index_type i = 1; i < num_tiles; ++i)
+  {
+    if(!heads_first[i])
+    {
+      carries_first[i] = wrapped_binary_op(carries_first[i - 1], carries_first[i]);
+    }
+  }
+
+  // scan each tile
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    InputIterator1 keys      = first1 + decomp[i].begin();
+    InputIterator1 keys_last = first1 + decomp[i].end();
+    InputIterator2 values    = first2 + decomp[i].begin();
+    OutputIterator output    = result + decomp[i].begin();
+
+    const bool head = leading_heads_first[i];
+
+    KeyType   prev_key = *keys;
+    ValueType value    = *values; // use temp to permit in-place scans
+    ValueType sum      = init;
+
+    if(!head)
+    {
+      sum = carries_first[i - 1];
+    }
+
+    *output = sum;
+    sum = wrapped_binary_op(sum, value);
+
+    for(++keys, ++values, ++output; keys != keys_last; ++keys, ++values, ++output)
+    {
+      KeyType key = *keys;
+
+      value = *values;
+
+      if(!wrapped_binary_pred(prev_key, key))
+        sum = init; // reset sum
+
+      *output = sum;
+      sum = wrapped_binary_op(sum, value);
+
+      prev_key = key;
+    }
+  }
+
+  return result + n;
+} // end exclusive_scan_by_key()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
+
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/shuffle.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/shuffle.h>
+#include <thrust/shuffle.h>
+#include <thrust/system/detail/generic/shuffle.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy, typename RandomIterator, typename URBG>
+  void shuffle(execution_policy<DerivedPolicy> &exec,
+               RandomIterator first,
+               RandomIterator last,
+               URBG &&g)
+{
+  typedef typename thrust::iterator_value<RandomIterator>::type InputType;
+
+  // the generic shuffle_copy may not write to its input, so the generic shuffle copies it first
+  if(static_cast<std::uint64_t>(thrust::distance(first, last)) <= thrust::system::detail::internal::shuffle_bucket_size(sizeof(InputType)))
+  {
+    thrust::system::detail::generic::shuffle(exec, first, last, g);
+    return;
+  }
+
+  // every element is read into the buffer before any is written back
+  thrust::system::omp::detail::shuffle_copy(exec, first, last, first, g);
+} // end shuffle()
+
+
+template<typename DerivedPolicy, typename RandomIterator, typename OutputIterator, typename URBG>
+  void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                    RandomIterator first,
+                    RandomIterator last,
+                    OutputIterator result,
+                    URBG &&g)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<RandomIterator>::type      InputType;
+  typedef typename thrust::iterator_difference<RandomIterator>::type difference_type;
+  typedef thrust::detail::intptr_t                                   index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return;
+
+  // a single bucket would be shuffled by one thread, while the Feistel bijection
+  // of the generic shuffle permutes it in parallel
+  const std::uint64_t bucket_size = thrust::system::detail::internal::shuffle_bucket_size(sizeof(InputType));
+
+  if(static_cast<std::uint64_t>(n) <= bucket_size)
+  {
+    thrust::system::detail::generic::shuffle_copy(exec, first, last, result, g);
+    return;
+  }
+
+  thrust::system::detail::internal::bucket_shuffle shuffler(n, bucket_size, g);
+
+  const index_type num_buckets = static_cast<index_type>(shuffler.num_buckets());
+  const index_type num_blocks  = static_cast<index_type>(shuffler.num_blocks());
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> blocks(n, 1, num_blocks);
+
+  // row i of counts holds the counts of block i
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> counts(exec, num_blocks * num_buckets);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> bucket_begin(exec, num_buckets + 1);
+  thrust::detail::temporary_array<InputType,DerivedPolicy>       buffer(exec, n);
+
+  difference_type *counts_ptr       = thrust::raw_pointer_cast(counts.data());
+  difference_type *bucket_begin_ptr = thrust::raw_pointer_cast(bucket_begin.data());
+  InputType       *buffer_ptr       = thrust::raw_pointer_cast(buffer.data());
+
+  // below the sequential cutoff, the calling thread makes the same permutation alone
+  const int threads = thrust::system::omp::detail::run_sequentially(exec, n) ? 1 : thrust::system::omp::detail::num_threads(exec);
+
+  // the loops take their schedule from exec
+  thrust::system::omp::detail::scoped_schedule schedule(exec);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) schedule(runtime) if(threads > 1))
+  for(index_type i = 0; i < num_blocks; ++i)
+  {
+    thrust::system::detail::internal::count_buckets(shuffler, blocks[i].begin(), blocks[i].end(), counts_ptr + i * num_buckets);
+  }
+
+  thrust::system::detail::internal::scan_buckets(shuffler, counts_ptr, bucket_begin_ptr);
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) schedule(runtime) if(threads > 1))
+  for(index_type i = 0; i < num_blocks; ++i)
+  {
+    thrust::system::detail::internal::scatter_buckets(shuffler, first, blocks[i].begin(), blocks[i].end(), buffer_ptr, counts_ptr + i * num_buckets);
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) schedule(runtime) if(threads > 1))
+  for(index_type b = 0; b < num_buckets; ++b)
+  {
+    thrust::system::detail::internal::shuffle_bucket(shuffler, buffer_ptr, bucket_begin_ptr, static_cast<difference_type>(b), result);
+  }
+} // end shuffle_copy()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -32,12 +32,29 @@
 #endif // omp support
 
 #include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
 #include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
 #include <thrust/system/detail/generic/select_system.h>
 #include <thrust/sort.h>
 #include <thrust/merge.h>
+#include <thrust/copy.h>
+#include <thrust/uninitialized_copy.h>
+#include <thrust/gather.h>
+#include <thrust/sequence.h>
 #include <thrust/detail/seq.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/minmax.h>
 #include <thrust/detail/temporary_array.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/index_sort.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+
+#include <cstddef>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -50,56 +67,161 @@ namespace sort_detail
 {
 
 
-template<typename DerivedPolicy,
-         typename RandomAccessIterator,
-         typename StrictWeakOrdering>
-void inplace_merge(execution_policy<DerivedPolicy> &exec,
-                   RandomAccessIterator first,
-                   RandomAccessIterator middle,
-                   RandomAccessIterator last,
-                   StrictWeakOrdering comp)
+// the sort proceeds in two phases:
+//   1. every thread stable sorts its own tile of the input sequentially
+//   2. sorted runs are merged pairwise, level by level, until a single run remains
+// in phase 2, every thread produces the same tile of the output at every level:
+// it locates the start and end of its tile along the merge path of the pair of
+// runs covering that tile and merges only that slice, so all threads stay busy
+// at every level, including the last
+// the merges ping-pong between the input and a single buffer allocated once per
+// sort; phase 1 sorts the tiles in whichever of the two makes the last level land
+// in the input, and copies a tile into the buffer only to sort it there or to
+// construct values which are not trivially copyable
+
+
+// the number of pairwise merge levels needed to reduce num_tiles runs to one
+template<typename IndexType>
+IndexType num_merge_levels(IndexType num_tiles)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+  IndexType result = 0;
 
-  thrust::detail::temporary_array<value_type,DerivedPolicy> a(exec, first, middle);
-  thrust::detail::temporary_array<value_type,DerivedPolicy> b(exec, middle, last);
+  for(IndexType width = 1; width < num_tiles; width *= 2)
+  {
+    ++result;
+  }
 
-  thrust::merge(thrust::seq, a.begin(), a.end(), b.begin(), b.end(), first, comp);
+  return result;
 }
 
 
-template<typename DerivedPolicy,
-         typename RandomAccessIterator1,
+// describes the slice of the merge of two runs which produces one output tile
+template<typename IndexType>
+struct merge_slice
+{
+  // offsets of the two runs in the source
+  IndexType first1, first2;
+
+  // offsets of the slice within the first and second run
+  IndexType begin1, end1, begin2, end2;
+
+  // whether the tile belongs to a run without a partner at this level
+  bool unpaired;
+};
+
+
+template<typename RandomAccessIterator, typename IndexType, typename StrictWeakOrdering>
+merge_slice<IndexType> locate_slice(RandomAccessIterator src,
+                                    const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp,
+                                    IndexType tile,
+                                    IndexType width,
+                                    StrictWeakOrdering comp)
+{
+  const IndexType num_tiles = decomp.size();
+
+  // the runs at this level span width tiles each
+  const IndexType tile1 = tile - tile % (2 * width);
+  const IndexType tile2 = tile1 + width;
+
+  merge_slice<IndexType> result;
+
+  result.unpaired = (tile2 >= num_tiles);
+
+  if(result.unpaired) return result;
+
+  const IndexType last_tile = thrust::min<IndexType>(tile1 + 2 * width, num_tiles) - 1;
+
+  result.first1 = decomp[tile1].begin();
+  result.first2 = decomp[tile2].begin();
+
+  const IndexType n1 = result.first2 - result.first1;
+  const IndexType n2 = decomp[last_tile].end() - result.first2;
+
+  // the diagonals of the merge path bounding this tile
+  const IndexType diag_begin = decomp[tile].begin() - result.first1;
+  const IndexType diag_end   = decomp[tile].end()   - result.first1;
+
+  result.begin1 = thrust::system::detail::internal::merge_path(src + result.first1, n1, src + result.first2, n2, diag_begin, comp);
+  result.end1   = thrust::system::detail::internal::merge_path(src + result.first1, n1, src + result.first2, n2, diag_end,   comp);
+  result.begin2 = diag_begin - result.begin1;
+  result.end2   = diag_end   - result.end1;
+
+  return result;
+}
+
+
+template<typename RandomAccessIterator1,
          typename RandomAccessIterator2,
+         typename IndexType,
          typename StrictWeakOrdering>
-void inplace_merge_by_key(execution_policy<DerivedPolicy> &exec,
-                          RandomAccessIterator1 first1,
-                          RandomAccessIterator1 middle1,
-                          RandomAccessIterator1 last1,
-                          RandomAccessIterator2 first2,
-                          StrictWeakOrdering comp)
+void merge_tile(RandomAccessIterator1 src,
+                RandomAccessIterator2 dst,
+                const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp,
+                IndexType tile,
+                IndexType width,
+                StrictWeakOrdering comp)
 {
-  typedef typename thrust::iterator_value<RandomAccessIterator1>::type value_type1;
-  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type2;
-
-  RandomAccessIterator2 middle2 = first2 + (middle1 - first1);
-  RandomAccessIterator2 last2   = first2 + (last1   - first1);
-
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> lhs1(exec, first1, middle1);
-  thrust::detail::temporary_array<value_type1,DerivedPolicy> rhs1(exec, middle1, last1);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> lhs2(exec, first2, middle2);
-  thrust::detail::temporary_array<value_type2,DerivedPolicy> rhs2(exec, middle2, last2);
-
-  thrust::merge_by_key(thrust::seq,
-                       lhs1.begin(), lhs1.end(),
-                       rhs1.begin(), rhs1.end(),
-                       lhs2.begin(), rhs2.begin(),
-                       first1, first2,
-                       comp);
+  merge_slice<IndexType> s = locate_slice(src, decomp, tile, width, comp);
+
+  if(s.unpaired)
+  {
+    thrust::copy(thrust::seq,
+                 src + decomp[tile].begin(),
+                 src + decomp[tile].end(),
+                 dst + decomp[tile].begin());
+  }
+  else
+  {
+    thrust::merge(thrust::seq,
+                  src + s.first1 + s.begin1, src + s.first1 + s.end1,
+                  src + s.first2 + s.begin2, src + s.first2 + s.end2,
+                  dst + decomp[tile].begin(),
+                  comp);
+  }
 }
 
 
-} // end sort_detail
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename IndexType,
+         typename StrictWeakOrdering>
+void merge_tile_by_key(RandomAccessIterator1 keys_src,
+                       RandomAccessIterator2 values_src,
+                       RandomAccessIterator3 keys_dst,
+                       RandomAccessIterator4 values_dst,
+                       const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp,
+                       IndexType tile,
+                       IndexType width,
+                       StrictWeakOrdering comp)
+{
+  merge_slice<IndexType> s = locate_slice(keys_src, decomp, tile, width, comp);
+
+  if(s.unpaired)
+  {
+    thrust::copy(thrust::seq,
+                 keys_src + decomp[tile].begin(),
+                 keys_src + decomp[tile].end(),
+                 keys_dst + decomp[tile].begin());
+
+    thrust::copy(thrust::seq,
+                 values_src + decomp[tile].begin(),
+                 values_src + decomp[tile].end(),
+                 values_dst + decomp[tile].begin());
+  }
+  else
+  {
+    thrust::merge_by_key(thrust::seq,
+                         keys_src + s.first1 + s.begin1, keys_src + s.first1 + s.end1,
+                         keys_src + s.first2 + s.begin2, keys_src + s.first2 + s.end2,
+                         values_src + s.first1 + s.begin1,
+                         values_src + s.first2 + s.begin2,
+                         keys_dst + decomp[tile].begin(),
+                         values_dst + decomp[tile].begin(),
+                         comp);
+  }
+}
 
 
 template<typename DerivedPolicy,
@@ -108,41 +230,72 @@ template<typename DerivedPolicy,
 void stable_sort(execution_policy<DerivedPolicy> &exec,
                  RandomAccessIterator first,
                  RandomAccessIterator last,
-                 StrictWeakOrdering comp)
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
 {
-  // we're attempting to launch an omp kernel, assert we're compiling with omp support
-  // ========================================================================
-  // X Note to the user: If you've found this line due to a compiler error, X
-  // X you need to enable OpenMP support in your compiler.                  X
-  // ========================================================================
-  THRUST_STATIC_ASSERT_MSG(
-    (thrust::detail::depend_on_instantiation<
-      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    >::value)
-  , "OpenMP compiler support is not enabled"
-  );
-
   // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      value_type;
 
   if(first == last)
     return;
 
-  THRUST_PRAGMA_OMP(parallel)
+  // wrap comp
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  // below the sequential cutoff, the calling thread sorts the input as a single tile, which is
+  // never merged, so the buffer is not allocated. the wrapped comparator also keeps the
+  // sequential radix sort out of this path
+  if(thrust::system::omp::detail::run_sequentially(exec, last - first))
+  {
+    thrust::stable_sort(thrust::seq, first, last, wrapped_comp);
+    return;
+  }
+
+  // the ping-pong buffer shared by every level of the merge, filled by the tiles
+  thrust::detail::temporary_array<value_type,DerivedPolicy> buffer(0, exec, last - first);
+  typename thrust::detail::temporary_array<value_type,DerivedPolicy>::iterator buffer_first = buffer.begin();
+
+  const bool trivial = thrust::detail::has_trivial_copy_constructor<value_type>::value;
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  THRUST_PRAGMA_OMP(parallel num_threads(threads))
   {
     thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(last - first, 1, omp_get_num_threads());
 
     // process id
     IndexType p_i = omp_get_thread_num();
 
+    const IndexType num_levels = num_merge_levels(decomp.size());
+
     // every thread sorts its own tile
     if(p_i < decomp.size())
     {
-      thrust::stable_sort(thrust::seq,
-                          first + decomp[p_i].begin(),
-                          first + decomp[p_i].end(),
-                          comp);
+      if(num_levels % 2 || !trivial)
+      {
+        thrust::uninitialized_copy(thrust::seq,
+                                   first + decomp[p_i].begin(),
+                                   first + decomp[p_i].end(),
+                                   buffer_first + decomp[p_i].begin());
+      }
+
+      // an odd number of merge levels starts from the buffer
+      if(num_levels % 2)
+      {
+        thrust::stable_sort(thrust::seq,
+                            buffer_first + decomp[p_i].begin(),
+                            buffer_first + decomp[p_i].end(),
+                            wrapped_comp);
+      }
+      else
+      {
+        thrust::stable_sort(thrust::seq,
+                            first + decomp[p_i].begin(),
+                            first + decomp[p_i].end(),
+                            wrapped_comp);
+      }
     }
 
     THRUST_PRAGMA_OMP(barrier)
@@ -150,32 +303,23 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
     // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
     ;
 
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
+    IndexType width = 1;
 
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
-
-    while(nseg>1)
+    for(IndexType level = 0; level < num_levels; ++level, width *= 2)
     {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
+      if(p_i < decomp.size())
       {
-        sort_detail::inplace_merge(exec,
-                                   first + decomp[a].begin(),
-                                   first + decomp[b].end(),
-                                   first + decomp[c].end(),
-                                   comp);
-
-        b = c;
-        c += h;
+        // the last level always writes into the input
+        if((num_levels - level) % 2)
+        {
+          merge_tile(buffer_first, first, decomp, p_i, width, wrapped_comp);
+        }
+        else
+        {
+          merge_tile(first, buffer_first, decomp, p_i, width, wrapped_comp);
+        }
       }
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
       THRUST_PRAGMA_OMP(barrier)
     }
   }
@@ -191,42 +335,87 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
                         RandomAccessIterator1 keys_first,
                         RandomAccessIterator1 keys_last,
                         RandomAccessIterator2 values_first,
-                        StrictWeakOrdering comp)
+                        StrictWeakOrdering comp,
+                        thrust::detail::false_type)
 {
-  // we're attempting to launch an omp kernel, assert we're compiling with omp support
-  // ========================================================================
-  // X Note to the user: If you've found this line due to a compiler error, X
-  // X you need to enable OpenMP support in your compiler.                  X
-  // ========================================================================
-  THRUST_STATIC_ASSERT_MSG(
-    (thrust::detail::depend_on_instantiation<
-      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
-    >::value)
-  , "OpenMP compiler support is not enabled"
-  );
-
   // Avoid issues on compilers that don't provide `omp_get_num_threads()`.
 #if (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
   typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type      key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      value_type;
 
   if(keys_first == keys_last)
     return;
 
-  THRUST_PRAGMA_OMP(parallel)
+  RandomAccessIterator2 values_last = values_first + (keys_last - keys_first);
+
+  // wrap comp
+  thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp(comp);
+
+  // below the sequential cutoff, the calling thread sorts the input as a single tile without
+  // allocating the buffers
+  if(thrust::system::omp::detail::run_sequentially(exec, keys_last - keys_first))
+  {
+    thrust::stable_sort_by_key(thrust::seq, keys_first, keys_last, values_first, wrapped_comp);
+    return;
+  }
+
+  // the ping-pong buffers shared by every level of the merge, filled by the tiles
+  thrust::detail::temporary_array<key_type,DerivedPolicy>   keys_buffer(0, exec, keys_last - keys_first);
+  thrust::detail::temporary_array<value_type,DerivedPolicy> values_buffer(0, exec, values_last - values_first);
+  typename thrust::detail::temporary_array<key_type,DerivedPolicy>::iterator   keys_buffer_first   = keys_buffer.begin();
+  typename thrust::detail::temporary_array<value_type,DerivedPolicy>::iterator values_buffer_first = values_buffer.begin();
+
+  const bool trivial_keys   = thrust::detail::has_trivial_copy_constructor<key_type>::value;
+  const bool trivial_values = thrust::detail::has_trivial_copy_constructor<value_type>::value;
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  THRUST_PRAGMA_OMP(parallel num_threads(threads))
   {
     thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(keys_last - keys_first, 1, omp_get_num_threads());
 
     // process id
     IndexType p_i = omp_get_thread_num();
 
+    const IndexType num_levels = num_merge_levels(decomp.size());
+
     // every thread sorts its own tile
     if(p_i < decomp.size())
     {
-      thrust::stable_sort_by_key(thrust::seq,
-                                 keys_first + decomp[p_i].begin(),
-                                 keys_first + decomp[p_i].end(),
-                                 values_first + decomp[p_i].begin(),
-                                 comp);
+      if(num_levels % 2 || !trivial_keys)
+      {
+        thrust::uninitialized_copy(thrust::seq,
+                                   keys_first + decomp[p_i].begin(),
+                                   keys_first + decomp[p_i].end(),
+                                   keys_buffer_first + decomp[p_i].begin());
+      }
+
+      if(num_levels % 2 || !trivial_values)
+      {
+        thrust::uninitialized_copy(thrust::seq,
+                                   values_first + decomp[p_i].begin(),
+                                   values_first + decomp[p_i].end(),
+                                   values_buffer_first + decomp[p_i].begin());
+      }
+
+      // an odd number of merge levels starts from the buffers
+      if(num_levels % 2)
+      {
+        thrust::stable_sort_by_key(thrust::seq,
+                                   keys_buffer_first + decomp[p_i].begin(),
+                                   keys_buffer_first + decomp[p_i].end(),
+                                   values_buffer_first + decomp[p_i].begin(),
+                                   wrapped_comp);
+      }
+      else
+      {
+        thrust::stable_sort_by_key(thrust::seq,
+                                   keys_first + decomp[p_i].begin(),
+                                   keys_first + decomp[p_i].end(),
+                                   values_first + decomp[p_i].begin(),
+                                   wrapped_comp);
+      }
     }
 
     THRUST_PRAGMA_OMP(barrier)
@@ -234,33 +423,27 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
     // XXX For some reason, MSVC 2015 yields an error unless we include this meaningless semicolon here
     ;
 
-    IndexType nseg = decomp.size();
-    IndexType h = 2;
-
-    // keep track of which sub-range we're processing
-    IndexType a=p_i, b=p_i, c=p_i+1;
+    IndexType width = 1;
 
-    while(nseg>1)
+    for(IndexType level = 0; level < num_levels; ++level, width *= 2)
     {
-      if(c >= decomp.size())
-        c = decomp.size() - 1;
-
-      if((p_i % h) == 0 && c > b)
+      if(p_i < decomp.size())
       {
-        sort_detail::inplace_merge_by_key(exec,
-                                          keys_first + decomp[a].begin(),
-                                          keys_first + decomp[b].end(),
-                                          keys_first + decomp[c].end(),
-                                          values_first + decomp[a].begin(),
-                                          comp);
-
-        b = c;
-        c += h;
+        // the last level always writes into the input
+        if((num_levels - level) % 2)
+        {
+          merge_tile_by_key(keys_buffer_first, values_buffer_first,
+                            keys_first, values_first,
+                            decomp, p_i, width, wrapped_comp);
+        }
+        else
+        {
+          merge_tile_by_key(keys_first, values_first,
+                            keys_buffer_first, values_buffer_first,
+                            decomp, p_i, width, wrapped_comp);
+        }
       }
 
-      nseg = (nseg + 1) / 2;
-      h *= 2;
-
       THRUST_PRAGMA_OMP(barrier)
     }
   }
@@ -268,6 +451,291 @@ void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
 }
 
 
+template<typename Encoder,
+         bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename IndexType>
+bool radix_pass(int threads,
+                const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp,
+                RandomAccessIterator1 keys_first,
+                RandomAccessIterator2 values_first,
+                RandomAccessIterator3 keys_result,
+                RandomAccessIterator4 values_result,
+                IndexType n,
+                unsigned int pass,
+                std::size_t *histograms)
+{
+  namespace radix_sort_detail = thrust::system::detail::internal::radix_sort_detail;
+
+  typedef thrust::detail::intptr_t index_type;
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    radix_sort_detail::histogram_tile<Encoder>(keys_first, decomp[i], pass, histograms + i * radix_sort_detail::radix_size);
+  }
+
+  if(!radix_sort_detail::scan_histograms(histograms, num_tiles, n))
+  {
+    return false;
+  }
+
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    radix_sort_detail::scatter_tile<Encoder,HasValues>(keys_first, values_first,
+                                                       keys_result, values_result,
+                                                       decomp[i], pass,
+                                                       histograms + i * radix_sort_detail::radix_size);
+  }
+
+  return true;
+}
+
+
+// LSD radix sort: every pass counts the digits of each tile in parallel, scans the
+// counts sequentially in bucket-major order, and scatters each tile in parallel
+template<typename Encoder,
+         bool HasValues,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4>
+void radix_sort(execution_policy<DerivedPolicy> &exec,
+                RandomAccessIterator1 keys1,
+                RandomAccessIterator2 keys2,
+                RandomAccessIterator3 vals1,
+                RandomAccessIterator4 vals2,
+                typename thrust::iterator_difference<RandomAccessIterator1>::type n)
+{
+  namespace radix_sort_detail = thrust::system::detail::internal::radix_sort_detail;
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  thrust::detail::temporary_array<std::size_t,DerivedPolicy> histograms(exec, decomp.size() * radix_sort_detail::radix_size);
+  std::size_t *histograms_ptr = thrust::raw_pointer_cast(histograms.data());
+
+  // false if most recent data is stored in (keys1,vals1)
+  bool flip = false;
+
+  for(unsigned int pass = 0; pass < Encoder::num_passes; ++pass)
+  {
+    const bool shuffled = flip ?
+      radix_pass<Encoder,HasValues>(threads, decomp, keys2, vals2, keys1, vals1, n, pass, histograms_ptr) :
+      radix_pass<Encoder,HasValues>(threads, decomp, keys1, vals1, keys2, vals2, n, pass, histograms_ptr);
+
+    if(shuffled)
+    {
+      flip = !flip;
+    }
+  }
+
+  // ensure final values are in (keys1,vals1)
+  if(flip)
+  {
+    thrust::copy(exec, keys2, keys2 + n, keys1);
+
+    if(HasValues)
+    {
+      thrust::copy(exec, vals2, vals2 + n, vals1);
+    }
+  }
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+  typedef thrust::system::detail::internal::radix_sort_detail::radix_encoder<key_type,StrictWeakOrdering> encoder;
+
+  const typename thrust::iterator_difference<RandomAccessIterator>::type n = last - first;
+
+  if(static_cast<std::size_t>(n) < thrust::system::detail::internal::radix_sort_detail::parallel_threshold)
+  {
+    // too few keys for the passes of the radix sort to pay off
+    stable_sort(exec, first, last, comp, thrust::detail::false_type());
+    return;
+  }
+
+  thrust::detail::temporary_array<key_type,DerivedPolicy> keys(exec, n);
+
+  radix_sort<encoder,false>(exec, first, keys.begin(), static_cast<int *>(0), static_cast<int *>(0), n);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type;
+  typedef thrust::system::detail::internal::radix_sort_detail::radix_encoder<key_type,StrictWeakOrdering> encoder;
+
+  const typename thrust::iterator_difference<RandomAccessIterator1>::type n = keys_last - keys_first;
+
+  if(static_cast<std::size_t>(n) < thrust::system::detail::internal::radix_sort_detail::parallel_threshold)
+  {
+    stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, thrust::detail::false_type());
+    return;
+  }
+
+  thrust::detail::temporary_array<key_type,DerivedPolicy>   keys(exec, n);
+  thrust::detail::temporary_array<value_type,DerivedPolicy> values(exec, n);
+
+  radix_sort<encoder,true>(exec, keys_first, keys.begin(), values_first, values.begin(), n);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename UseRadixSort>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        UseRadixSort use_radix_sort,
+                        thrust::detail::false_type)
+{
+  stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, use_radix_sort);
+}
+
+
+// sorts the keys together with the indices of their values, then moves each value once
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename UseRadixSort>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp,
+                        UseRadixSort use_radix_sort,
+                        thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type index_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      value_type;
+
+  const index_type n = thrust::distance(keys_first, keys_last);
+
+  thrust::detail::temporary_array<index_type,DerivedPolicy> indices(exec, n);
+  thrust::sequence(exec, indices.begin(), indices.end());
+
+  stable_sort_by_key(exec, keys_first, keys_last, indices.begin(), comp, use_radix_sort);
+
+  thrust::detail::temporary_array<value_type,DerivedPolicy> values(exec, values_first, n);
+  thrust::gather(exec, indices.begin(), indices.end(), values.begin(), values_first);
+}
+
+
+} // end sort_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  // primitive keys compared with less or greater take the radix sort
+  thrust::system::detail::internal::radix_sort_detail::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, thrust::distance(first, last)))
+  {
+    // the merge sort hands small inputs to the sequential merge sort before allocating its buffer
+    sort_detail::stable_sort(exec, first, last, comp, thrust::detail::false_type());
+    return;
+  }
+
+  sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                        RandomAccessIterator1 keys_first,
+                        RandomAccessIterator1 keys_last,
+                        RandomAccessIterator2 values_first,
+                        StrictWeakOrdering comp)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator1, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type value_type;
+
+  // primitive keys compared with less or greater take the radix sort
+  thrust::system::detail::internal::radix_sort_detail::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
+
+  // large values follow their keys by index
+  thrust::system::detail::internal::use_index_sort<value_type> use_index_sort;
+
+  if(thrust::system::omp::detail::run_sequentially(exec, thrust::distance(keys_first, keys_last)))
+  {
+    sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, thrust::detail::false_type());
+    return;
+  }
+
+  sort_detail::stable_sort_by_key(exec, keys_first, keys_last, values_first, comp, use_radix_sort, use_index_sort);
+}
+
+
 } // end namespace detail
 } // end namespace omp
 } // end namespace system
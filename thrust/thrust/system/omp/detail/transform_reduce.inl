@@ -0,0 +1,152 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/transform_reduce.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/reduce_intervals.h>
+#include <thrust/system/detail/internal/transform_reduce.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/distance.h>
+#include <thrust/transform_reduce.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+namespace transform_reduce_detail
+{
+
+
+// reduces init with f(0), ..., f(n - 1), where f(i) is a function of the i-th element(s) of the input
+// the tiles are reduced in parallel and their sums are reduced with init in order
+template<typename DerivedPolicy,
+         typename Size,
+         typename IndexFunction,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType reduce_indices(execution_policy<DerivedPolicy> &exec,
+                            Size n,
+                            IndexFunction f,
+                            OutputType init,
+                            BinaryFunction binary_op)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      IndexFunction, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef thrust::detail::intptr_t index_type;
+
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  thrust::detail::temporary_array<OutputType,DerivedPolicy> partial_sums(exec, num_tiles);
+
+  // the i-th value is f(i); no tile of a nonempty range is empty
+  thrust::transform_iterator<IndexFunction,thrust::counting_iterator<Size>,OutputType> values(thrust::counting_iterator<Size>(0), f);
+
+  thrust::system::omp::detail::reduce_intervals(exec, values, partial_sums.begin(), binary_op, decomp);
+
+  // wrap binary_op
+  thrust::detail::wrapped_function<BinaryFunction,OutputType> wrapped_binary_op(binary_op);
+
+  OutputType sum = init;
+
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    sum = wrapped_binary_op(sum, partial_sums[i]);
+  }
+
+  return sum;
+} // end reduce_indices()
+
+
+} // end transform_reduce_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename UnaryFunction,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType transform_reduce(execution_policy<DerivedPolicy> &exec,
+                              InputIterator first,
+                              InputIterator last,
+                              UnaryFunction unary_op,
+                              OutputType init,
+                              BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return init;
+  }
+  else if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::transform_reduce(thrust::seq, first, last, unary_op, init, binary_op);
+  }
+
+  // wrap unary_op
+  thrust::detail::wrapped_function<UnaryFunction,OutputType> wrapped_unary_op(unary_op);
+
+  typedef thrust::system::detail::internal::transform_at<
+    InputIterator,
+    thrust::detail::wrapped_function<UnaryFunction,OutputType>,
+    OutputType
+  > IndexFunction;
+
+  return transform_reduce_detail::reduce_indices(exec, n, IndexFunction(first, wrapped_unary_op), init, binary_op);
+} // end transform_reduce()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
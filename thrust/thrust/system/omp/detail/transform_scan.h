@@ -26,6 +26,7 @@
 #  pragma system_header
 #endif // no system header
 
-// this system inherits transform_scan
-#include <thrust/system/cpp/detail/transform_scan.h>
+// this system has no special version of this algorithm
+// generic::transform_inclusive_scan and generic::transform_exclusive_scan
+// dispatch to omp::detail::inclusive_scan and omp::detail::exclusive_scan
 
@@ -14,6 +14,10 @@
  *  limitations under the License.
  */
 
+/*! \file uninitialized_fill.h
+ *  \brief OpenMP implementation of uninitialized_fill.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
@@ -25,7 +29,41 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/system/omp/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+// the storage of omp vectors is constructed here, so each page is first touched by
+// the thread which a static schedule assigns its tile of the default decomposition.
+// on NUMA systems, the pages are then local to the threads of algorithms executed
+// with that schedule. elements whose copy constructor may throw are constructed
+// sequentially
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  RandomAccessIterator uninitialized_fill_n(execution_policy<DerivedPolicy> &exec,
+                                            RandomAccessIterator first,
+                                            Size n,
+                                            const T &x);
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename T>
+  void uninitialized_fill(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator first,
+                          RandomAccessIterator last,
+                          const T &x);
 
-// this system inherits uninitialized_fill
-#include <thrust/system/cpp/detail/uninitialized_fill.h>
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
 
+#include <thrust/system/omp/detail/uninitialized_fill.inl>
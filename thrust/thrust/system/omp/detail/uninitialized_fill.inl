@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/omp/detail/uninitialized_fill.h>
+#include <thrust/system/omp/detail/default_decomposition.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/uninitialized_fill.h>
+
+#include <type_traits>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace omp
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  RandomAccessIterator uninitialized_fill_n(execution_policy<DerivedPolicy> &exec,
+                                            RandomAccessIterator first,
+                                            Size n,
+                                            const T &x)
+{
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      RandomAccessIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  if(n <= 0) return first;
+
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  // a copy constructor which throws inside the parallel loop would terminate the program, so
+  // only elements which are copied without throwing are first touched in parallel
+  if(!std::is_nothrow_constructible<value_type, const T&>::value ||
+     thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::uninitialized_fill_n(thrust::seq, first, n, x);
+  }
+
+  typedef thrust::detail::intptr_t index_type;
+
+  thrust::system::detail::internal::uniform_decomposition<Size> decomp = thrust::system::omp::detail::default_decomposition(exec, n);
+
+  const index_type num_tiles = static_cast<index_type>(decomp.size());
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  // unlike the loops of other algorithms, this one ignores the schedule of exec: the
+  // tiles of the first touch are assigned to threads in order
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) schedule(static))
+  for(index_type i = 0; i < num_tiles; ++i)
+  {
+    thrust::uninitialized_fill_n(thrust::seq, first + decomp[i].begin(), decomp[i].size(), x);
+  }
+
+  return first + n;
+} // end uninitialized_fill_n()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename T>
+  void uninitialized_fill(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator first,
+                          RandomAccessIterator last,
+                          const T &x)
+{
+  thrust::system::omp::detail::uninitialized_fill_n(exec, first, thrust::distance(first, last), x);
+} // end uninitialized_fill()
+
+
+} // end namespace detail
+} // end namespace omp
+} // end namespace system
+THRUST_NAMESPACE_END
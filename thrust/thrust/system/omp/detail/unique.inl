@@ -26,8 +26,16 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/omp/detail/unique.h>
-#include <thrust/system/detail/generic/unique.h>
+#include <thrust/system/omp/detail/compact.h>
+#include <thrust/system/omp/detail/parallelism.h>
+#include <thrust/system/omp/detail/pragma_omp.h>
+#include <thrust/detail/static_assert.h>
+#include <thrust/detail/cstdint.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
 #include <thrust/pair.h>
+#include <thrust/unique.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -46,8 +54,9 @@ template<typename DerivedPolicy,
                          ForwardIterator last,
                          BinaryPredicate binary_pred)
 {
-  // omp prefers generic::unique to cpp::unique
-  return thrust::system::detail::generic::unique(exec,first,last,binary_pred);
+  compact_detail::unique_selector<ForwardIterator,BinaryPredicate> select(first, binary_pred);
+
+  return thrust::system::omp::detail::compact_in_place(exec, first, last, select);
 } // end unique()
 
 
@@ -61,8 +70,9 @@ template<typename DerivedPolicy,
                              OutputIterator output,
                              BinaryPredicate binary_pred)
 {
-  // omp prefers generic::unique_copy to cpp::unique_copy
-  return thrust::system::detail::generic::unique_copy(exec,first,last,output,binary_pred);
+  compact_detail::unique_selector<InputIterator,BinaryPredicate> select(first, binary_pred);
+
+  return thrust::system::omp::detail::compact(exec, first, last, output, select);
 } // end unique_copy()
 
 
@@ -75,8 +85,45 @@ template<typename DerivedPolicy,
                  ForwardIterator last,
                  BinaryPredicate binary_pred)
 {
-  // omp prefers generic::unique_count to cpp::unique_count
-  return thrust::system::detail::generic::unique_count(exec,first,last,binary_pred);
+  // we're attempting to launch an omp kernel, assert we're compiling with omp support
+  // ========================================================================
+  // X Note to the user: If you've found this line due to a compiler error, X
+  // X you need to enable OpenMP support in your compiler.                  X
+  // ========================================================================
+  THRUST_STATIC_ASSERT_MSG(
+    (thrust::detail::depend_on_instantiation<
+      ForwardIterator, (THRUST_DEVICE_COMPILER_IS_OMP_CAPABLE == THRUST_TRUE)
+    >::value)
+  , "OpenMP compiler support is not enabled"
+  );
+
+  typedef typename thrust::iterator_traits<ForwardIterator>::difference_type difference_type;
+  typedef thrust::detail::intptr_t                                          index_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(thrust::system::omp::detail::run_sequentially(exec, n))
+  {
+    return thrust::unique_count(thrust::seq, first, last, binary_pred);
+  }
+
+  compact_detail::unique_selector<ForwardIterator,BinaryPredicate> select(first, binary_pred);
+
+  difference_type count = 0;
+
+  const int threads = thrust::system::omp::detail::num_threads(exec);
+
+  // count the heads of the groups directly rather than materializing them
+  THRUST_PRAGMA_OMP(parallel for num_threads(threads) reduction(+:count))
+  for(index_type i = 0; i < static_cast<index_type>(n); ++i)
+  {
+    if(select(i))
+    {
+      ++count;
+    }
+  }
+
+  return count;
 } // end unique_count()
 
 
@@ -69,9 +69,11 @@
 #include <thrust/system/omp/detail/scatter.h>
 #include <thrust/system/omp/detail/sequence.h>
 #include <thrust/system/omp/detail/set_operations.h>
+#include <thrust/system/omp/detail/shuffle.h>
 #include <thrust/system/omp/detail/sort.h>
 #include <thrust/system/omp/detail/swap_ranges.h>
 #include <thrust/system/omp/detail/tabulate.h>
+#include <thrust/system/omp/detail/temporary_buffer.h>
 #include <thrust/system/omp/detail/transform.h>
 #include <thrust/system/omp/detail/transform_reduce.h>
 #include <thrust/system/omp/detail/transform_scan.h>
@@ -123,6 +125,24 @@ struct tag : thrust::system::omp::execution_policy<tag> { unspecified };
  *
  *  The type of \p thrust::omp::par is implementation-defined.
  *
+ *  The number of threads executing an algorithm may be requested with \p thrust::omp::par.num_threads(n),
+ *  and the schedule of its parallel loops with \p thrust::omp::par.schedule(kind, chunk), where \p kind is
+ *  one of \p thrust::omp::schedule_static, \p thrust::omp::schedule_dynamic or \p thrust::omp::schedule_guided.
+ *  Both may be combined with each other and with an allocator, as in
+ *  \p thrust::omp::par(alloc).num_threads(4).schedule(thrust::omp::schedule_dynamic, 64).
+ *  Otherwise, the OpenMP defaults apply.
+ *
+ *  Algorithms given fewer elements than \p THRUST_OMP_SEQUENTIAL_CUTOFF (4096 unless defined
+ *  before including Thrust) run sequentially on the calling thread instead of opening a parallel
+ *  region. The cutoff of a single call may be set with \p thrust::omp::par.sequential_cutoff(n);
+ *  a cutoff of zero always executes in parallel.
+ *
+ *  The temporary storage of algorithms is cached by a pool of the calling thread, up to 256 MiB per
+ *  thread, so repeated invocations do not return to the system allocator. The storage cached by every
+ *  thread is released with \p thrust::omp::release_temporary_storage(). Defining
+ *  \p THRUST_OMP_DISABLE_TEMPORARY_POOL before including Thrust allocates it with \p thrust::omp::malloc
+ *  instead. Temporary storage of \p thrust::omp::par(alloc) always comes from \p alloc.
+ *
  *  The following code snippet demonstrates how to use \p thrust::omp::par to explicitly dispatch an
  *  invocation of \p thrust::for_each to the OpenMP backend system:
  *
@@ -72,6 +72,14 @@ inline pointer<T> malloc(std::size_t n);
  */
 inline void free(pointer<void> ptr);
 
+/*! Returns the temporary storage cached by every thread to the system.
+ *  Unless \p THRUST_OMP_DISABLE_TEMPORARY_POOL is defined, the temporary storage of
+ *  algorithms dispatched to the <tt>omp</tt> system is cached by a pool of the thread
+ *  which invokes them, up to 256 MiB, and is otherwise only released when that thread exits.
+ *  Storage in use by an algorithm running on another thread is cached again once it is returned.
+ */
+inline void release_temporary_storage();
+
 /*! \p omp::allocator is the default allocator used by the \p omp system's
  *  containers such as <tt>omp::vector</tt> if no user-specified allocator is
  *  provided. \p omp::allocator allocates (deallocates) storage with \p
@@ -99,6 +107,7 @@ namespace omp
 {
 using thrust::system::omp::malloc;
 using thrust::system::omp::free;
+using thrust::system::omp::release_temporary_storage;
 using thrust::system::omp::allocator;
 using thrust::system::omp::universal_allocator;
 } // namespace omp
@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/adjacent_difference.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/adjacent_difference.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/adjacent_difference.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace adjacent_difference_detail
+{
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename InputType,
+         typename BinaryFunction,
+         typename Size>
+struct body
+{
+  InputIterator first;
+  OutputIterator result;
+  const InputType *boundaries;
+  BinaryFunction binary_op;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp;
+
+  body(InputIterator first,
+       OutputIterator result,
+       const InputType *boundaries,
+       BinaryFunction binary_op,
+       const thrust::system::detail::internal::uniform_decomposition<Size> &decomp)
+    : first(first), result(result), boundaries(boundaries), binary_op(binary_op), decomp(decomp)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      const Size begin = decomp[i].begin();
+
+      thrust::system::detail::internal::adjacent_difference_tile(first, begin, decomp[i].end(), result, binary_op);
+
+      // the first element of the tile is written last, after the tile has read it
+      OutputIterator out = result + begin;
+
+      if(i == 0)
+      {
+        *out = first[0];
+      }
+      else
+      {
+        *out = binary_op(thrust::raw_reference_cast(first[begin]), boundaries[i]);
+      }
+    }
+  }
+}; // end body
+
+
+} // end adjacent_difference_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename BinaryFunction>
+  OutputIterator adjacent_difference(execution_policy<DerivedPolicy> &exec,
+                                     InputIterator first,
+                                     InputIterator last,
+                                     OutputIterator result,
+                                     BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_value<InputIterator>::type      InputType;
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return result;
+  }
+  else if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::adjacent_difference(thrust::seq, first, last, result, binary_op);
+  }
+
+  // one tile per thread of exec's arena
+  const difference_type p = thrust::max<difference_type>(1, thrust::system::tbb::detail::concurrency(exec));
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp(n, 1, p);
+
+  const difference_type num_tiles = decomp.size();
+
+  // boundaries[i] is the element preceding tile i, saved before any tile is written
+  thrust::detail::temporary_array<InputType,DerivedPolicy> boundaries(exec, num_tiles);
+
+  InputType *boundaries_ptr = thrust::raw_pointer_cast(boundaries.data());
+
+  for(difference_type i = 1; i < num_tiles; ++i)
+  {
+    boundaries_ptr[i] = first[decomp[i].begin() - 1];
+  }
+
+  typedef adjacent_difference_detail::body<InputIterator,OutputIterator,InputType,BinaryFunction,difference_type> Body;
+
+  ::tbb::blocked_range<difference_type> tiles(0, num_tiles, 1);
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, Body(first, result, boundaries_ptr, binary_op, decomp));
+
+  return result + n;
+} // end adjacent_difference()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
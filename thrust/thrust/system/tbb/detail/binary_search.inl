@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2008-2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/binary_search.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/vectorized_search.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/sort.h>
+#include <tbb/blocked_range.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+
+template<typename Search,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename Size,
+         typename StrictWeakOrdering>
+struct probe_body
+{
+  RandomAccessIterator1 first;
+  Size n;
+  RandomAccessIterator2 values;
+  RandomAccessIterator3 output;
+  StrictWeakOrdering comp;
+
+  probe_body(RandomAccessIterator1 first, Size n, RandomAccessIterator2 values, RandomAccessIterator3 output, StrictWeakOrdering comp)
+    : first(first), n(n), values(values), output(output), comp(comp)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    thrust::system::detail::internal::probe_search<Search>(first, n, values, output, r.begin(), r.end(), comp);
+  }
+};
+
+
+template<typename Search,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename Size,
+         typename StrictWeakOrdering>
+struct merge_body
+{
+  RandomAccessIterator1 first;
+  Size n;
+  RandomAccessIterator2 values;
+  Size m;
+  RandomAccessIterator3 output;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp;
+  StrictWeakOrdering comp;
+
+  merge_body(RandomAccessIterator1 first, Size n,
+             RandomAccessIterator2 values, Size m,
+             RandomAccessIterator3 output,
+             const thrust::system::detail::internal::uniform_decomposition<Size> &decomp,
+             StrictWeakOrdering comp)
+    : first(first), n(n), values(values), m(m), output(output), decomp(decomp), comp(comp)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      thrust::system::detail::internal::merge_search<Search>(first, n, values, m, output, decomp[i].begin(), decomp[i].end(), comp);
+    }
+  }
+};
+
+
+template<typename Search,
+         typename DerivedPolicy,
+         typename ForwardIterator,
+         typename InputIterator,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+OutputIterator vectorized_search(execution_policy<DerivedPolicy> &exec,
+                                 ForwardIterator begin,
+                                 ForwardIterator end,
+                                 InputIterator values_begin,
+                                 InputIterator values_end,
+                                 OutputIterator output,
+                                 StrictWeakOrdering comp)
+{
+  typedef typename thrust::iterator_difference<ForwardIterator>::type difference_type;
+  typedef thrust::detail::wrapped_function<StrictWeakOrdering,bool>   wrapped_comp_type;
+
+  const difference_type n = thrust::distance(begin, end);
+  const difference_type m = thrust::distance(values_begin, values_end);
+
+  // wrap comp
+  wrapped_comp_type wrapped_comp(comp);
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, m))
+  {
+    thrust::system::detail::internal::probe_search<Search>(begin, n, values_begin, output, difference_type(0), m, wrapped_comp);
+
+    return output + m;
+  }
+
+  if(thrust::system::detail::internal::use_merge_search(n, m) && thrust::is_sorted(exec, values_begin, values_end, comp))
+  {
+    // one tile of the merge per thread of exec's arena
+    const difference_type p = thrust::max<difference_type>(1, thrust::system::tbb::detail::concurrency(exec));
+
+    thrust::system::detail::internal::uniform_decomposition<difference_type> decomp(n + m, 1, p);
+
+    ::tbb::blocked_range<difference_type> tiles(0, decomp.size(), 1);
+
+    thrust::system::tbb::detail::parallel_for(exec, tiles, merge_body<Search,ForwardIterator,InputIterator,OutputIterator,difference_type,wrapped_comp_type>(begin, n, values_begin, m, output, decomp, wrapped_comp));
+  }
+  else
+  {
+    ::tbb::blocked_range<difference_type> range(0, m, thrust::system::tbb::detail::grain_size(exec, difference_type(1)));
+
+    thrust::system::tbb::detail::parallel_for(exec, range, probe_body<Search,ForwardIterator,InputIterator,OutputIterator,difference_type,wrapped_comp_type>(begin, n, values_begin, output, wrapped_comp));
+  }
+
+  return output + m;
+} // end vectorized_search()
+
+
+} // end namespace binary_search_detail
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator lower_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  typedef thrust::system::detail::internal::vectorized_search_detail::lower_bound_search Search;
+
+  return binary_search_detail::vectorized_search<Search>(exec, begin, end, values_begin, values_end, output, comp);
+} // end lower_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator upper_bound(execution_policy<DerivedPolicy> &exec,
+                           ForwardIterator begin,
+                           ForwardIterator end,
+                           InputIterator values_begin,
+                           InputIterator values_end,
+                           OutputIterator output,
+                           StrictWeakOrdering comp)
+{
+  typedef thrust::system::detail::internal::vectorized_search_detail::upper_bound_search Search;
+
+  return binary_search_detail::vectorized_search<Search>(exec, begin, end, values_begin, values_end, output, comp);
+} // end upper_bound()
+
+
+template <typename DerivedPolicy, typename ForwardIterator, typename InputIterator, typename OutputIterator, typename StrictWeakOrdering>
+OutputIterator binary_search(execution_policy<DerivedPolicy> &exec,
+                             ForwardIterator begin,
+                             ForwardIterator end,
+                             InputIterator values_begin,
+                             InputIterator values_end,
+                             OutputIterator output,
+                             StrictWeakOrdering comp)
+{
+  typedef thrust::system::detail::internal::vectorized_search_detail::binary_search_search Search;
+
+  return binary_search_detail::vectorized_search<Search>(exec, begin, end, values_begin, values_end, output, comp);
+} // end binary_search()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
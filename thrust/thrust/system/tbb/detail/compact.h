@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file compact.h
+ *  \brief TBB implementations of the stream compaction underlying
+ *         copy_if, remove_if, unique, unique_by_key and stable_partition_copy.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/detail/function.h>
+#include <thrust/pair.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace compact_detail
+{
+
+
+// selects the i-th element when pred holds for the i-th element of the stencil
+template<typename InputIterator, typename Predicate>
+struct stencil_selector
+{
+  InputIterator stencil;
+  thrust::detail::wrapped_function<Predicate,bool> pred;
+
+  stencil_selector(InputIterator stencil, Predicate pred)
+    : stencil(stencil), pred(pred)
+  {}
+
+  template<typename IndexType>
+  bool operator()(IndexType i) const
+  {
+    return pred(stencil[i]);
+  }
+};
+
+
+// selects the first element of each group of consecutive equivalent elements
+template<typename InputIterator, typename BinaryPredicate>
+struct unique_selector
+{
+  InputIterator first;
+  thrust::detail::wrapped_function<BinaryPredicate,bool> binary_pred;
+
+  unique_selector(InputIterator first, BinaryPredicate binary_pred)
+    : first(first), binary_pred(binary_pred)
+  {}
+
+  template<typename IndexType>
+  bool operator()(IndexType i) const
+  {
+    return i == 0 || !binary_pred(first[i - 1], first[i]);
+  }
+};
+
+
+} // end namespace compact_detail
+
+
+// copies the elements of [first, last) chosen by select(i) to result, preserving their order
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename Selector>
+  OutputIterator compact(execution_policy<DerivedPolicy> &exec,
+                         InputIterator first,
+                         InputIterator last,
+                         OutputIterator result,
+                         Selector select);
+
+
+// moves the elements of [first, last) chosen by select(i) to the front of the range,
+// preserving their order; select(i) may inspect the i-th and (i-1)-th elements of the range
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Selector>
+  RandomAccessIterator compact_in_place(execution_policy<DerivedPolicy> &exec,
+                                        RandomAccessIterator first,
+                                        RandomAccessIterator last,
+                                        Selector select);
+
+
+// copies the elements of [first, last) chosen by select(i) to out_true and the others
+// to out_false, preserving their order
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Selector>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    compact_partition(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      OutputIterator1 out_true,
+                      OutputIterator2 out_false,
+                      Selector select);
+
+
+// moves the elements of [first, last) chosen by select(i) to the front of the range and
+// the others after them, preserving the order of both; the range is staged through
+// buffer, which holds at least last - first uninitialized elements, all of which are
+// constructed; select(i) is evaluated once, while the i-th element of the range is intact
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Selector>
+  RandomAccessIterator1 compact_partition_in_place(execution_policy<DerivedPolicy> &exec,
+                                                   RandomAccessIterator1 first,
+                                                   RandomAccessIterator1 last,
+                                                   RandomAccessIterator2 buffer,
+                                                   Selector select);
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/tbb/detail/compact.inl>
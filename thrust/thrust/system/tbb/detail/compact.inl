@@ -0,0 +1,541 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/compact.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/compact.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/scan.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace compact_detail
+{
+
+
+// compact and compact_partition make a single parallel_scan over the input:
+// the pre-scan of a range only counts the elements it selects, and the final
+// scan of a range writes them, knowing how many elements precede it
+// the only temporary storage is the count carried by each body
+
+
+template<typename InputIterator,
+         typename OutputIterator,
+         typename Selector,
+         typename Size>
+struct compact_body
+{
+  InputIterator first;
+  OutputIterator result;
+  Selector select;
+  Size sum;
+
+  compact_body(InputIterator first, OutputIterator result, Selector select)
+    : first(first), result(result), select(select), sum(0)
+  {}
+
+  compact_body(compact_body &b, ::tbb::split)
+    : first(b.first), result(b.result), select(b.select), sum(0)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r, ::tbb::pre_scan_tag)
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      if(select(i))
+      {
+        ++sum;
+      }
+    }
+  }
+
+  void operator()(const ::tbb::blocked_range<Size> &r, ::tbb::final_scan_tag)
+  {
+    OutputIterator out = result + sum;
+
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      if(select(i))
+      {
+        *out = first[i];
+        ++out;
+        ++sum;
+      }
+    }
+  }
+
+  void reverse_join(compact_body &b)
+  {
+    sum = b.sum + sum;
+  }
+
+  void assign(compact_body &b)
+  {
+    sum = b.sum;
+  }
+}; // end compact_body
+
+
+// sum counts the selected elements, so the unselected elements preceding
+// a range number its beginning less sum
+template<typename InputIterator,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Selector,
+         typename Size>
+struct compact_partition_body
+{
+  InputIterator first;
+  OutputIterator1 out_true;
+  OutputIterator2 out_false;
+  Selector select;
+  Size sum;
+
+  compact_partition_body(InputIterator first, OutputIterator1 out_true, OutputIterator2 out_false, Selector select)
+    : first(first), out_true(out_true), out_false(out_false), select(select), sum(0)
+  {}
+
+  compact_partition_body(compact_partition_body &b, ::tbb::split)
+    : first(b.first), out_true(b.out_true), out_false(b.out_false), select(b.select), sum(0)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r, ::tbb::pre_scan_tag)
+  {
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      if(select(i))
+      {
+        ++sum;
+      }
+    }
+  }
+
+  void operator()(const ::tbb::blocked_range<Size> &r, ::tbb::final_scan_tag)
+  {
+    OutputIterator1 true_out  = out_true  + sum;
+    OutputIterator2 false_out = out_false + (r.begin() - sum);
+
+    for(Size i = r.begin(); i != r.end(); ++i)
+    {
+      if(select(i))
+      {
+        *true_out = first[i];
+        ++true_out;
+        ++sum;
+      }
+      else
+      {
+        *false_out = first[i];
+        ++false_out;
+      }
+    }
+  }
+
+  void reverse_join(compact_partition_body &b)
+  {
+    sum = b.sum + sum;
+  }
+
+  void assign(compact_partition_body &b)
+  {
+    sum = b.sum;
+  }
+}; // end compact_partition_body
+
+
+// stages each tile in buffer, its selected elements in front of the others, and records how
+// many it selected
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Selector,
+         typename Size>
+struct stage_tile_body
+{
+  RandomAccessIterator1 first;
+  RandomAccessIterator2 buffer;
+  Selector select;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp;
+  Size *counts;
+
+  stage_tile_body(RandomAccessIterator1 first,
+                  RandomAccessIterator2 buffer,
+                  Selector select,
+                  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp,
+                  Size *counts)
+    : first(first), buffer(buffer), select(select), decomp(decomp), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      counts[i] = thrust::system::detail::internal::stage_partition_range(first, buffer, decomp[i].begin(), decomp[i].end(), select);
+    }
+  }
+}; // end stage_tile_body
+
+
+// writes the staged tiles back from buffer to their place in the partition
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size>
+struct unstage_tile_body
+{
+  RandomAccessIterator1 first;
+  RandomAccessIterator2 buffer;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp;
+  const Size *offsets;
+
+  unstage_tile_body(RandomAccessIterator1 first,
+                    RandomAccessIterator2 buffer,
+                    const thrust::system::detail::internal::uniform_decomposition<Size> &decomp,
+                    const Size *offsets)
+    : first(first), buffer(buffer), decomp(decomp), offsets(offsets)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    // offsets[num_tiles] is the size of the true partition
+    const Size num_selected = offsets[decomp.size()];
+
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      thrust::system::detail::internal::unstage_partition_range(buffer,
+                                                                decomp[i].begin(),
+                                                                decomp[i].end(),
+                                                                offsets[i + 1] - offsets[i],
+                                                                first + offsets[i],
+                                                                first + (num_selected + decomp[i].begin() - offsets[i]));
+    }
+  }
+}; // end unstage_tile_body
+
+
+// compacts each tile to its own front and records how many elements it kept
+template<typename RandomAccessIterator,
+         typename Selector,
+         typename Size>
+struct compact_tile_body
+{
+  RandomAccessIterator first;
+  Selector select;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp;
+  Size *counts;
+
+  compact_tile_body(RandomAccessIterator first,
+                    Selector select,
+                    const thrust::system::detail::internal::uniform_decomposition<Size> &decomp,
+                    Size *counts)
+    : first(first), select(select), decomp(decomp), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      counts[i] = thrust::system::detail::internal::compact_range_in_place(first, decomp[i].begin(), decomp[i].end(), select);
+    }
+  }
+}; // end compact_tile_body
+
+
+// stashes the compacted tiles in the scratch buffer
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size>
+struct stash_tile_body
+{
+  RandomAccessIterator1 first;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp;
+  const Size *offsets;
+  RandomAccessIterator2 scratch;
+
+  stash_tile_body(RandomAccessIterator1 first,
+                  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp,
+                  const Size *offsets,
+                  RandomAccessIterator2 scratch)
+    : first(first), decomp(decomp), offsets(offsets), scratch(scratch)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      thrust::system::detail::internal::stash_compacted_tile(first, decomp, offsets, i, scratch);
+    }
+  }
+}; // end stash_tile_body
+
+
+// restores the compacted tiles from the scratch buffer at their offsets
+template<typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Size>
+struct restore_tile_body
+{
+  RandomAccessIterator1 first;
+  const Size *offsets;
+  RandomAccessIterator2 scratch;
+
+  restore_tile_body(RandomAccessIterator1 first,
+                    const Size *offsets,
+                    RandomAccessIterator2 scratch)
+    : first(first), offsets(offsets), scratch(scratch)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      thrust::system::detail::internal::restore_compacted_tile(first, offsets, i, scratch);
+    }
+  }
+}; // end restore_tile_body
+
+
+} // end namespace compact_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator,
+         typename Selector>
+  OutputIterator compact(execution_policy<DerivedPolicy> &exec,
+                         InputIterator first,
+                         InputIterator last,
+                         OutputIterator result,
+                         Selector select)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef compact_detail::compact_body<InputIterator,OutputIterator,Selector,difference_type> Body;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return result;
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    for(difference_type j = 0; j < n; ++j)
+    {
+      if(select(j))
+      {
+        *result = first[j];
+        ++result;
+      }
+    }
+
+    return result;
+  }
+
+  Body body(first, result, select);
+  ::tbb::blocked_range<difference_type> range(0, n, thrust::system::tbb::detail::grain_size(exec, difference_type(1)));
+  thrust::system::tbb::detail::parallel_scan(exec, range, body);
+
+  return result + body.sum;
+} // end compact()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Selector>
+  RandomAccessIterator compact_in_place(execution_policy<DerivedPolicy> &exec,
+                                        RandomAccessIterator first,
+                                        RandomAccessIterator last,
+                                        Selector select)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator>::type difference_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type      value_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return first;
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return first + thrust::system::detail::internal::compact_range_in_place(first, difference_type(0), n, select);
+  }
+
+  // a single scan could write over elements of a range before it reads them,
+  // so each tile is compacted to its own front first
+
+  // one tile per thread of exec's arena
+  const difference_type p = thrust::max<difference_type>(1, thrust::system::tbb::detail::concurrency(exec));
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp(n, 1, p);
+
+  const difference_type num_tiles = decomp.size();
+
+  // offsets[i] is the position in the output of tile i
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  ::tbb::blocked_range<difference_type> tiles(0, num_tiles, 1);
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, compact_detail::compact_tile_body<RandomAccessIterator,Selector,difference_type>(first, select, decomp, offsets_ptr));
+
+  offsets_ptr[num_tiles] = 0;
+
+  // offsets[num_tiles] becomes the size of the output
+  thrust::exclusive_scan(thrust::seq, offsets_ptr, offsets_ptr + num_tiles + 1, offsets_ptr);
+
+  // move the compacted tiles to their offsets through a scratch buffer
+  // the second loop starts once the first has stashed every tile
+  if(!thrust::system::detail::internal::compacted_tiles_in_place(decomp, offsets_ptr))
+  {
+    typedef thrust::detail::temporary_array<value_type,DerivedPolicy> scratch_type;
+
+    scratch_type scratch(0, exec, thrust::system::detail::internal::compacted_scratch_size(decomp, offsets_ptr));
+
+    ::tbb::blocked_range<difference_type> moved_tiles(1, num_tiles, 1);
+
+    thrust::system::tbb::detail::parallel_for(exec, moved_tiles, compact_detail::stash_tile_body<RandomAccessIterator,typename scratch_type::iterator,difference_type>(first, decomp, offsets_ptr, scratch.begin()));
+    thrust::system::tbb::detail::parallel_for(exec, moved_tiles, compact_detail::restore_tile_body<RandomAccessIterator,typename scratch_type::iterator,difference_type>(first, offsets_ptr, scratch.begin()));
+  }
+
+  return first + offsets_ptr[num_tiles];
+} // end compact_in_place()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename OutputIterator1,
+         typename OutputIterator2,
+         typename Selector>
+  thrust::pair<OutputIterator1,OutputIterator2>
+    compact_partition(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      OutputIterator1 out_true,
+                      OutputIterator2 out_false,
+                      Selector select)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+  typedef compact_detail::compact_partition_body<InputIterator,OutputIterator1,OutputIterator2,Selector,difference_type> Body;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return thrust::make_pair(out_true, out_false);
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    for(difference_type j = 0; j < n; ++j)
+    {
+      if(select(j))
+      {
+        *out_true = first[j];
+        ++out_true;
+      }
+      else
+      {
+        *out_false = first[j];
+        ++out_false;
+      }
+    }
+
+    return thrust::make_pair(out_true, out_false);
+  }
+
+  Body body(first, out_true, out_false, select);
+  ::tbb::blocked_range<difference_type> range(0, n, thrust::system::tbb::detail::grain_size(exec, difference_type(1)));
+  thrust::system::tbb::detail::parallel_scan(exec, range, body);
+
+  return thrust::make_pair(out_true + body.sum, out_false + (n - body.sum));
+} // end compact_partition()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename Selector>
+  RandomAccessIterator1 compact_partition_in_place(execution_policy<DerivedPolicy> &exec,
+                                                   RandomAccessIterator1 first,
+                                                   RandomAccessIterator1 last,
+                                                   RandomAccessIterator2 buffer,
+                                                   Selector select)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return first;
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return first + thrust::system::detail::internal::partition_range_in_place(first, buffer, n, select);
+  }
+
+  // the first pass stages each tile in buffer, its selected elements in front of the others,
+  // and the second writes them back from buffer to their place in the partition
+
+  // one tile per thread of exec's arena
+  const difference_type p = thrust::max<difference_type>(1, thrust::system::tbb::detail::concurrency(exec));
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp(n, 1, p);
+
+  const difference_type num_tiles = decomp.size();
+
+  // offsets[i] is the position in the true partition of tile i;
+  // its position in the false partition follows as the number of preceding elements not selected
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  ::tbb::blocked_range<difference_type> tiles(0, num_tiles, 1);
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, compact_detail::stage_tile_body<RandomAccessIterator1,RandomAccessIterator2,Selector,difference_type>(first, buffer, select, decomp, offsets_ptr));
+
+  offsets_ptr[num_tiles] = 0;
+
+  // offsets[num_tiles] becomes the size of the true partition
+  thrust::exclusive_scan(thrust::seq, offsets_ptr, offsets_ptr + num_tiles + 1, offsets_ptr);
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, compact_detail::unstage_tile_body<RandomAccessIterator1,RandomAccessIterator2,difference_type>(first, buffer, decomp, offsets_ptr));
+
+  return first + offsets_ptr[num_tiles];
+} // end compact_partition_in_place()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
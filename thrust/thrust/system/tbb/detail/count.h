@@ -14,6 +14,11 @@
  *  limitations under the License.
  */
 
+
+/*! \file count.h
+ *  \brief TBB implementation of count_if.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
@@ -25,7 +30,29 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/iterator/iterator_traits.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// each tile counts the matches of pred in a plain loop over the input rather than
+// through a transform_iterator; generic::count builds on it
+template<typename DerivedPolicy, typename InputIterator, typename Predicate>
+  typename thrust::iterator_traits<InputIterator>::difference_type
+    count_if(execution_policy<DerivedPolicy> &exec,
+             InputIterator first,
+             InputIterator last,
+             Predicate pred);
 
-// this system inherits count
-#include <thrust/system/cpp/detail/count.h>
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
 
+#include <thrust/system/tbb/detail/count.inl>
@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/count.h>
+#include <thrust/system/tbb/detail/transform_reduce.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/transform_reduce.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/count.h>
+#include <thrust/functional.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy, typename InputIterator, typename Predicate>
+  typename thrust::iterator_traits<InputIterator>::difference_type
+    count_if(execution_policy<DerivedPolicy> &exec,
+             InputIterator first,
+             InputIterator last,
+             Predicate pred)
+{
+  typedef typename thrust::iterator_traits<InputIterator>::difference_type CountType;
+
+  const CountType n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return CountType(0);
+  }
+  else if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::count_if(thrust::seq, first, last, pred);
+  }
+
+  // wrap pred
+  thrust::detail::wrapped_function<Predicate,bool> wrapped_pred(pred);
+
+  typedef thrust::system::detail::internal::count_if_at<
+    InputIterator,
+    thrust::detail::wrapped_function<Predicate,bool>,
+    CountType
+  > IndexFunction;
+
+  return transform_reduce_detail::reduce_indices(exec, n, IndexFunction(first, wrapped_pred), CountType(0), thrust::plus<CountType>());
+} // end count_if()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -36,18 +36,17 @@ namespace tbb
 namespace detail
 {
 
+// the range is searched in blocks, and blocks beyond the first match found so far are
+// skipped; generic::mismatch, equal, all_of, any_of, none_of and is_sorted_until build on it
 template <typename DerivedPolicy, typename InputIterator, typename Predicate>
 InputIterator find_if(execution_policy<DerivedPolicy> &exec,
                       InputIterator first,
                       InputIterator last,
-                      Predicate pred)
-{
-  // tbb prefers generic::find_if to cpp::find_if
-  return thrust::system::detail::generic::find_if(exec, first, last, pred);
-}
+                      Predicate pred);
 
 } // end namespace detail
 } // end namespace tbb
 } // end namespace system
 THRUST_NAMESPACE_END
 
+#include <thrust/system/tbb/detail/find.inl>
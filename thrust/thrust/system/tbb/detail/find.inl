@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2008-2021 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/find.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/find_if.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/find.h>
+#include <tbb/blocked_range.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace find_detail
+{
+
+
+template<typename RandomAccessIterator, typename Size, typename Predicate>
+struct find_if_body
+{
+  RandomAccessIterator first;
+  thrust::detail::wrapped_function<Predicate,bool> pred;
+  thrust::system::detail::internal::first_match<Size> &result;
+
+  find_if_body(RandomAccessIterator first, Predicate pred, thrust::system::detail::internal::first_match<Size> &result)
+    : first(first), pred(pred), result(result)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    thrust::system::detail::internal::find_if_block(first, r.begin(), r.end(), pred, result);
+  }
+};
+
+
+} // end namespace find_detail
+
+
+template <typename DerivedPolicy, typename InputIterator, typename Predicate>
+InputIterator find_if(execution_policy<DerivedPolicy> &exec,
+                      InputIterator first,
+                      InputIterator last,
+                      Predicate pred)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::find_if(thrust::seq, first, last, pred);
+  }
+
+  thrust::system::detail::internal::first_match<difference_type> result(n);
+
+  // the leaves of the range hold about a block each, and a leaf beyond the first match is skipped
+  const difference_type block_size = thrust::system::detail::internal::find_if_block_size;
+
+  ::tbb::blocked_range<difference_type> range(0, n, thrust::system::tbb::detail::grain_size(exec, block_size));
+
+  thrust::system::tbb::detail::parallel_for(exec, range, find_detail::find_if_body<InputIterator,difference_type,Predicate>(first, pred, result));
+
+  return first + result.get();
+} // end find_if()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
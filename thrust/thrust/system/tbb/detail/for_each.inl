@@ -30,6 +30,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
 #include <thrust/system/detail/sequential/execution_policy.h>
+#include <thrust/system/tbb/detail/parallelism.h>
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -79,12 +80,19 @@ template<typename DerivedPolicy,
          typename RandomAccessIterator,
          typename Size,
          typename UnaryFunction>
-RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &,
+RandomAccessIterator for_each_n(execution_policy<DerivedPolicy> &exec,
                                 RandomAccessIterator first,
                                 Size n,
                                 UnaryFunction f)
 {
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0,n), for_each_detail::make_body<Size>(first,f));
+  if (thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::for_each_n(thrust::system::detail::sequential::seq, first, n, f);
+  }
+
+  ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+
+  thrust::system::tbb::detail::parallel_for(exec, range, for_each_detail::make_body<Size>(first,f));
 
   // return the end of the range
   return first + n;
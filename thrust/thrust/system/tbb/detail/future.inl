@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp14_required.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <thrust/system/tbb/future.h>
+#include <thrust/system/tbb/detail/par.h>
+#include <thrust/system/detail/internal/eager_future.h>
+
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <tuple>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace tbb
+{
+
+namespace detail
+{
+
+
+// the task is run and waited for in the arena of the policy, if any. only the
+// owner of the signal waits for its group, since a dependent task is the sole
+// owner of each of its dependencies
+class task_group_signal : public thrust::system::detail::internal::eager_signal
+{
+public:
+  template <typename Task>
+  task_group_signal(::tbb::task_arena* arena, Task task)
+    : arena_(arena), done_(false)
+  {
+    execute([&]
+    {
+      group_.run(body<Task>{this, task});
+    });
+  }
+
+  // the task catches its exceptions, so waiting for it does not throw
+  ~task_group_signal() noexcept
+  {
+    execute([&]
+    {
+      group_.wait();
+    });
+  }
+
+  bool ready() const
+  {
+    return done_.load(std::memory_order_acquire);
+  }
+
+  void wait()
+  {
+    execute([&]
+    {
+      group_.wait();
+    });
+
+    if (error_) std::rethrow_exception(error_);
+  }
+
+private:
+  // the exception of the task is kept for every call to wait()
+  template <typename Task>
+  struct body
+  {
+    task_group_signal* self;
+    Task task;
+
+    void operator()() const
+    {
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        self->error_ = std::current_exception();
+      }
+
+      self->done_.store(true, std::memory_order_release);
+    }
+  };
+
+  template <typename Function>
+  void execute(Function f)
+  {
+    if (arena_) arena_->execute(f);
+    else f();
+  }
+
+  ::tbb::task_arena* arena_;
+  ::tbb::task_group group_;
+  std::atomic<bool> done_;
+  std::exception_ptr error_;
+};
+
+
+struct launch_task_group
+{
+  typedef tag system_tag;
+
+  ::tbb::task_arena* arena;
+
+  template <typename Task>
+  std::unique_ptr<thrust::system::detail::internal::eager_signal>
+  operator()(Task task) const
+  {
+    return std::unique_ptr<thrust::system::detail::internal::eager_signal>(new task_group_signal(arena, task));
+  }
+};
+
+
+// the launch hook of the asynchronous algorithms in system/detail/internal/async
+template <typename DerivedPolicy>
+_CCCL_HOST
+launch_task_group eager_launch(execution_policy<DerivedPolicy>& exec)
+{
+  launch_task_group launch = {get_arena(thrust::detail::derived_cast(exec))};
+
+  return launch;
+}
+
+
+} // namespace detail
+
+template <typename... Events>
+_CCCL_HOST
+unique_eager_event when_all(Events&&... evs)
+{
+  return thrust::system::detail::internal::make_joined_event<tag>(
+    std::make_tuple(std::move(evs)...)
+  );
+}
+
+}} // namespace system::tbb
+
+THRUST_NAMESPACE_END
+
+#endif // C++14
+
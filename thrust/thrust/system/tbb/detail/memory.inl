@@ -28,6 +28,10 @@
 #include <thrust/system/cpp/detail/execution_policy.h>
 #include <thrust/system/tbb/memory.h>
 #include <thrust/system/cpp/memory.h>
+
+#if _CCCL_STD_VER >= 2011 && !defined(THRUST_TBB_DISABLE_TEMPORARY_POOL)
+#include <thrust/system/detail/internal/temporary_pool.h>
+#endif
 #include <limits>
 
 THRUST_NAMESPACE_BEGIN
@@ -89,6 +93,13 @@ inline void free(pointer<void> ptr)
   detail::free_workaround(cpp::tag(), ptr);
 } // end free()
 
+inline void release_temporary_storage()
+{
+#if _CCCL_STD_VER >= 2011 && !defined(THRUST_TBB_DISABLE_TEMPORARY_POOL)
+  thrust::system::detail::internal::release_temporary_pool();
+#endif
+} // end release_temporary_storage()
+
 } // end tbb
 } // end system
 THRUST_NAMESPACE_END
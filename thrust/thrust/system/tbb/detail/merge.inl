@@ -29,6 +29,7 @@
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/temporary_array.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/parallelism.h>
 #include <thrust/merge.h>
 #include <thrust/binary_search.h>
 #include <thrust/detail/seq.h>
@@ -236,7 +237,7 @@ template<typename DerivedPolicy,
          typename InputIterator2,
          typename OutputIterator,
          typename StrictWeakOrdering>
-OutputIterator merge(execution_policy<DerivedPolicy> &,
+OutputIterator merge(execution_policy<DerivedPolicy> &exec,
                      InputIterator1 first1,
                      InputIterator1 last1,
                      InputIterator2 first2,
@@ -244,12 +245,17 @@ OutputIterator merge(execution_policy<DerivedPolicy> &,
                      OutputIterator result,
                      StrictWeakOrdering comp)
 {
+  if (thrust::system::tbb::detail::run_sequentially(exec, thrust::distance(first1, last1) + thrust::distance(first2, last2)))
+  {
+    return thrust::merge(thrust::seq, first1, last1, first2, last2, result, comp);
+  }
+
   typedef typename merge_detail::range<InputIterator1,InputIterator2,OutputIterator,StrictWeakOrdering> Range;
   typedef          merge_detail::body                                                                   Body;
-  Range range(first1, last1, first2, last2, result, comp);
+  Range range(first1, last1, first2, last2, result, comp, thrust::system::tbb::detail::grain_size(exec, size_t(1024)));
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  thrust::system::tbb::detail::parallel_for(exec, range, body);
 
   thrust::advance(result, thrust::distance(first1, last1) + thrust::distance(first2, last2));
 
@@ -265,7 +271,7 @@ template <typename DerivedPolicy,
           typename OutputIterator2,
           typename StrictWeakOrdering>
 thrust::pair<OutputIterator1,OutputIterator2>
-  merge_by_key(execution_policy<DerivedPolicy> &,
+  merge_by_key(execution_policy<DerivedPolicy> &exec,
                InputIterator1 keys_first1,
                InputIterator1 keys_last1,
                InputIterator2 keys_first2,
@@ -276,13 +282,18 @@ thrust::pair<OutputIterator1,OutputIterator2>
                OutputIterator2 values_result,
                StrictWeakOrdering comp)
 {
+  if (thrust::system::tbb::detail::run_sequentially(exec, thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2)))
+  {
+    return thrust::merge_by_key(thrust::seq, keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp);
+  }
+
   typedef typename merge_by_key_detail::range<InputIterator1,InputIterator2,InputIterator3,InputIterator4,OutputIterator1,OutputIterator2,StrictWeakOrdering> Range;
   typedef          merge_by_key_detail::body                                                                                                                  Body;
 
-  Range range(keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp);
+  Range range(keys_first1, keys_last1, keys_first2, keys_last2, values_first3, values_first4, keys_result, values_result, comp, thrust::system::tbb::detail::grain_size(exec, size_t(1024)));
   Body  body;
 
-  ::tbb::parallel_for(range, body);
+  thrust::system::tbb::detail::parallel_for(exec, range, body);
 
   thrust::advance(keys_result,   thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
   thrust::advance(values_result, thrust::distance(keys_first1, keys_last1) + thrust::distance(keys_first2, keys_last2));
@@ -26,26 +26,299 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/detail/allocator_aware_execution_policy.h>
+#if _CCCL_STD_VER >= 2011
+#  include <thrust/detail/dependencies_aware_execution_policy.h>
+#endif
 #include <thrust/system/tbb/detail/execution_policy.h>
 
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+#include <atomic>
+#include <cstddef>
+
+// algorithms given fewer elements than this run sequentially rather than pay
+// for spawning tasks; par.sequential_cutoff() overrides it per call
+#ifndef THRUST_TBB_SEQUENTIAL_CUTOFF
+#define THRUST_TBB_SEQUENTIAL_CUTOFF 4096
+#endif
+
 THRUST_NAMESPACE_BEGIN
 namespace system
 {
 namespace tbb
 {
+
+
+// the partitioners which may be requested with par.partitioner()
+enum partitioner_kind
+{
+  partitioner_auto,
+  partitioner_simple,
+  partitioner_static,
+  partitioner_affinity
+};
+
+
+namespace detail
+{
+
+
+class affinity_claim;
+
+
+} // end detail
+
+
+// algorithms invoked with par.affinity(h) share the affinity_partitioner of h, so
+// a loop over a range of the same size is scheduled onto the threads which
+// visited each chunk during the previous loop with h
+// only one loop at a time may use the partitioner: the loops nested within it, such as
+// the merges of a merge sort, and loops invoked concurrently with h by other threads
+// run with the auto partitioner instead
+class affinity_handle
+{
+public:
+  affinity_handle() : claimed_(false) {}
+
+private:
+  affinity_handle(const affinity_handle &) = delete;
+  affinity_handle &operator=(const affinity_handle &) = delete;
+
+  ::tbb::affinity_partitioner partitioner_;
+
+  // set while a loop uses partitioner_
+  std::atomic<bool> claimed_;
+
+  friend class detail::affinity_claim;
+};
+
+
+namespace detail
+{
+
+
+// claims the partitioner of an affinity handle, if no other loop uses it, until destroyed
+class affinity_claim
+{
+public:
+  explicit affinity_claim(affinity_handle *h)
+    : handle_(h && !h->claimed_.exchange(true) ? h : 0)
+  {}
+
+  ~affinity_claim()
+  {
+    if(handle_)
+    {
+      handle_->claimed_.store(false);
+    }
+  }
+
+  // the partitioner of the handle, or null when there is no handle or another loop uses it
+  ::tbb::affinity_partitioner *partitioner() const
+  {
+    return handle_ ? &handle_->partitioner_ : 0;
+  }
+
+private:
+  affinity_claim(const affinity_claim &) = delete;
+  affinity_claim &operator=(const affinity_claim &) = delete;
+
+  affinity_handle *handle_;
+};
+
+
+} // end detail
+
+
 namespace detail
 {
 
 
+struct partitioner_request
+{
+  // when false, each algorithm chooses its own partitioner
+  bool requested;
+  partitioner_kind kind;
+
+  _CCCL_HOST_DEVICE
+  partitioner_request()
+    : requested(false), kind(partitioner_auto)
+  {}
+
+  _CCCL_HOST_DEVICE
+  explicit partitioner_request(partitioner_kind kind_)
+    : requested(true), kind(kind_)
+  {}
+};
+
+
+template<typename Derived>
+struct execute_with_parallelism_base : thrust::system::tbb::detail::execution_policy<Derived>
+{
+private:
+  // a negative cutoff selects THRUST_TBB_SEQUENTIAL_CUTOFF
+  std::ptrdiff_t sequential_cutoff_;
+
+  // a null arena selects the arena of the calling thread
+  ::tbb::task_arena *arena_;
+
+  partitioner_request partitioner_;
+
+  // a grain size of zero selects the default grain size of each algorithm
+  std::size_t grain_size_;
+
+  affinity_handle *affinity_;
+
+public:
+  _CCCL_HOST_DEVICE
+  execute_with_parallelism_base()
+    : sequential_cutoff_(-1), arena_(0), partitioner_(), grain_size_(0), affinity_(0)
+  {}
+
+  Derived sequential_cutoff(std::ptrdiff_t n) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.sequential_cutoff_ = n;
+    return result;
+  }
+
+  // the arena is not copied and must outlive every algorithm invoked with the result
+  Derived arena(::tbb::task_arena &a) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.arena_ = &a;
+    return result;
+  }
+
+  Derived partitioner(partitioner_kind kind) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.partitioner_ = partitioner_request(kind);
+    return result;
+  }
+
+  Derived grain_size(std::size_t n) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.grain_size_ = n;
+    return result;
+  }
+
+  // the handle is not copied and must outlive every algorithm invoked with the result
+  Derived affinity(affinity_handle &h) const
+  {
+    Derived result = thrust::detail::derived_cast(*this);
+    result.affinity_ = &h;
+    return result;
+  }
+
+private:
+  friend std::ptrdiff_t get_sequential_cutoff(const execute_with_parallelism_base &exec)
+  {
+    return exec.sequential_cutoff_;
+  }
+
+  friend ::tbb::task_arena *get_arena(const execute_with_parallelism_base &exec)
+  {
+    return exec.arena_;
+  }
+
+  friend partitioner_request get_partitioner(const execute_with_parallelism_base &exec)
+  {
+    return exec.partitioner_;
+  }
+
+  friend std::size_t get_grain_size(const execute_with_parallelism_base &exec)
+  {
+    return exec.grain_size_;
+  }
+
+  friend affinity_handle *get_affinity(const execute_with_parallelism_base &exec)
+  {
+    return exec.affinity_;
+  }
+};
+
+
+struct execute_with_parallelism : execute_with_parallelism_base<execute_with_parallelism>
+{};
+
+
 struct par_t : thrust::system::tbb::detail::execution_policy<par_t>,
   thrust::detail::allocator_aware_execution_policy<
-    thrust::system::tbb::detail::execution_policy>
+    execute_with_parallelism_base>
+#if _CCCL_STD_VER >= 2011
+, thrust::detail::dependencies_aware_execution_policy<
+    execute_with_parallelism_base>
+#endif
 {
   _CCCL_HOST_DEVICE
   constexpr par_t() : thrust::system::tbb::detail::execution_policy<par_t>() {}
+
+  execute_with_parallelism sequential_cutoff(std::ptrdiff_t n) const
+  {
+    return execute_with_parallelism().sequential_cutoff(n);
+  }
+
+  execute_with_parallelism arena(::tbb::task_arena &a) const
+  {
+    return execute_with_parallelism().arena(a);
+  }
+
+  execute_with_parallelism partitioner(partitioner_kind kind) const
+  {
+    return execute_with_parallelism().partitioner(kind);
+  }
+
+  execute_with_parallelism grain_size(std::size_t n) const
+  {
+    return execute_with_parallelism().grain_size(n);
+  }
+
+  execute_with_parallelism affinity(affinity_handle &h) const
+  {
+    return execute_with_parallelism().affinity(h);
+  }
 };
 
 
+// policies other than those built from par run with the defaults
+template<typename DerivedPolicy>
+std::ptrdiff_t get_sequential_cutoff(execution_policy<DerivedPolicy> &)
+{
+  return -1;
+}
+
+
+template<typename DerivedPolicy>
+::tbb::task_arena *get_arena(execution_policy<DerivedPolicy> &)
+{
+  return 0;
+}
+
+
+template<typename DerivedPolicy>
+partitioner_request get_partitioner(execution_policy<DerivedPolicy> &)
+{
+  return partitioner_request();
+}
+
+
+template<typename DerivedPolicy>
+std::size_t get_grain_size(execution_policy<DerivedPolicy> &)
+{
+  return 0;
+}
+
+
+template<typename DerivedPolicy>
+affinity_handle *get_affinity(execution_policy<DerivedPolicy> &)
+{
+  return 0;
+}
+
+
 } // end detail
 
 
@@ -62,6 +335,12 @@ namespace tbb
 
 
 using thrust::system::tbb::par;
+using thrust::system::tbb::partitioner_kind;
+using thrust::system::tbb::partitioner_auto;
+using thrust::system::tbb::partitioner_simple;
+using thrust::system::tbb::partitioner_static;
+using thrust::system::tbb::partitioner_affinity;
+using thrust::system::tbb::affinity_handle;
 
 
 } // end tbb
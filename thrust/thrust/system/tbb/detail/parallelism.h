@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file parallelism.h
+ *  \brief The sequential cutoff, task arena, partitioner and grain size with
+ *         which the TBB system executes a policy.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/par.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+// returns true when exec should process n elements sequentially: n is below
+// the cutoff requested with par.sequential_cutoff(), or else THRUST_TBB_SEQUENTIAL_CUTOFF
+template<typename DerivedPolicy, typename Size>
+bool run_sequentially(execution_policy<DerivedPolicy> &exec, Size n);
+
+
+// returns the number of threads which may execute exec: the concurrency of the arena
+// requested with par.arena(), or else that of the calling thread's arena
+template<typename DerivedPolicy>
+int concurrency(execution_policy<DerivedPolicy> &exec);
+
+
+// returns the grain size requested with par.grain_size(), or else default_grain_size
+// the grain size counts elements, so only loops over elements honor it
+template<typename DerivedPolicy, typename Size>
+Size grain_size(execution_policy<DerivedPolicy> &exec, Size default_grain_size);
+
+
+// calls f() in the arena requested with par.arena(), or else in the calling thread's arena
+template<typename DerivedPolicy, typename Function>
+void execute(execution_policy<DerivedPolicy> &exec, const Function &f);
+
+
+// ::tbb::parallel_for, ::tbb::parallel_reduce and ::tbb::parallel_scan executed in the arena
+// of exec with the partitioner requested with par.partitioner(), or else default_kind
+// parallel_for and parallel_reduce reuse the affinity_partitioner of the handle requested with par.affinity(),
+// unless another loop, such as one they are nested within, uses it
+// parallel_scan only accepts the auto and simple partitioners, so the others scan with auto
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_for(execution_policy<DerivedPolicy> &exec,
+                  const Range &range,
+                  const Body &body,
+                  partitioner_kind default_kind = partitioner_auto);
+
+
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_reduce(execution_policy<DerivedPolicy> &exec,
+                     const Range &range,
+                     Body &body,
+                     partitioner_kind default_kind = partitioner_auto);
+
+
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_scan(execution_policy<DerivedPolicy> &exec,
+                   const Range &range,
+                   Body &body,
+                   partitioner_kind default_kind = partitioner_auto);
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
+#include <thrust/system/tbb/detail/parallelism.inl>
@@ -0,0 +1,294 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/detail/execution_policy.h>
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+template<typename DerivedPolicy, typename Size>
+bool run_sequentially(execution_policy<DerivedPolicy> &exec, Size n)
+{
+  std::ptrdiff_t cutoff = get_sequential_cutoff(thrust::detail::derived_cast(exec));
+
+  if(cutoff < 0)
+  {
+    cutoff = THRUST_TBB_SEQUENTIAL_CUTOFF;
+  }
+
+  return static_cast<std::ptrdiff_t>(n) < cutoff;
+} // end run_sequentially()
+
+
+template<typename DerivedPolicy>
+int concurrency(execution_policy<DerivedPolicy> &exec)
+{
+  ::tbb::task_arena *arena = get_arena(thrust::detail::derived_cast(exec));
+
+  return arena ? arena->max_concurrency() : ::tbb::this_task_arena::max_concurrency();
+} // end concurrency()
+
+
+template<typename DerivedPolicy, typename Size>
+Size grain_size(execution_policy<DerivedPolicy> &exec, Size default_grain_size)
+{
+  const std::size_t requested = get_grain_size(thrust::detail::derived_cast(exec));
+
+  return requested > 0 ? static_cast<Size>(requested) : default_grain_size;
+} // end grain_size()
+
+
+template<typename DerivedPolicy, typename Function>
+void execute(execution_policy<DerivedPolicy> &exec, const Function &f)
+{
+  ::tbb::task_arena *arena = get_arena(thrust::detail::derived_cast(exec));
+
+  if(arena)
+  {
+    arena->execute(f);
+  }
+  else
+  {
+    f();
+  }
+} // end execute()
+
+
+namespace parallelism_detail
+{
+
+
+template<typename DerivedPolicy>
+partitioner_kind partitioner(execution_policy<DerivedPolicy> &exec, partitioner_kind default_kind)
+{
+  // an affinity handle implies the affinity partitioner
+  if(get_affinity(thrust::detail::derived_cast(exec)))
+  {
+    return partitioner_affinity;
+  }
+
+  const partitioner_request request = get_partitioner(thrust::detail::derived_cast(exec));
+
+  return request.requested ? request.kind : default_kind;
+}
+
+
+template<typename Range, typename Body>
+struct parallel_for_closure
+{
+  const Range &range;
+  const Body &body;
+  partitioner_kind kind;
+  affinity_handle *affinity;
+
+  parallel_for_closure(const Range &range, const Body &body, partitioner_kind kind, affinity_handle *affinity)
+    : range(range), body(body), kind(kind), affinity(affinity)
+  {}
+
+  void operator()() const
+  {
+    switch(kind)
+    {
+      case partitioner_simple:
+      {
+        ::tbb::parallel_for(range, body, ::tbb::simple_partitioner());
+        break;
+      }
+      case partitioner_static:
+      {
+        ::tbb::parallel_for(range, body, ::tbb::static_partitioner());
+        break;
+      }
+      case partitioner_affinity:
+      {
+        affinity_claim claim(affinity);
+
+        if(claim.partitioner())
+        {
+          ::tbb::parallel_for(range, body, *claim.partitioner());
+        }
+        else if(affinity)
+        {
+          // the loop is nested within, or concurrent with, another loop using the handle
+          ::tbb::parallel_for(range, body, ::tbb::auto_partitioner());
+        }
+        else
+        {
+          ::tbb::affinity_partitioner partitioner;
+          ::tbb::parallel_for(range, body, partitioner);
+        }
+        break;
+      }
+      default:
+      {
+        ::tbb::parallel_for(range, body, ::tbb::auto_partitioner());
+        break;
+      }
+    }
+  }
+};
+
+
+template<typename Range, typename Body>
+struct parallel_reduce_closure
+{
+  const Range &range;
+  Body &body;
+  partitioner_kind kind;
+  affinity_handle *affinity;
+
+  parallel_reduce_closure(const Range &range, Body &body, partitioner_kind kind, affinity_handle *affinity)
+    : range(range), body(body), kind(kind), affinity(affinity)
+  {}
+
+  void operator()() const
+  {
+    switch(kind)
+    {
+      case partitioner_simple:
+      {
+        ::tbb::parallel_reduce(range, body, ::tbb::simple_partitioner());
+        break;
+      }
+      case partitioner_static:
+      {
+        ::tbb::parallel_reduce(range, body, ::tbb::static_partitioner());
+        break;
+      }
+      case partitioner_affinity:
+      {
+        affinity_claim claim(affinity);
+
+        if(claim.partitioner())
+        {
+          ::tbb::parallel_reduce(range, body, *claim.partitioner());
+        }
+        else if(affinity)
+        {
+          // the loop is nested within, or concurrent with, another loop using the handle
+          ::tbb::parallel_reduce(range, body, ::tbb::auto_partitioner());
+        }
+        else
+        {
+          ::tbb::affinity_partitioner partitioner;
+          ::tbb::parallel_reduce(range, body, partitioner);
+        }
+        break;
+      }
+      default:
+      {
+        ::tbb::parallel_reduce(range, body, ::tbb::auto_partitioner());
+        break;
+      }
+    }
+  }
+};
+
+
+template<typename Range, typename Body>
+struct parallel_scan_closure
+{
+  const Range &range;
+  Body &body;
+  partitioner_kind kind;
+
+  parallel_scan_closure(const Range &range, Body &body, partitioner_kind kind)
+    : range(range), body(body), kind(kind)
+  {}
+
+  void operator()() const
+  {
+    if(kind == partitioner_simple)
+    {
+      ::tbb::parallel_scan(range, body, ::tbb::simple_partitioner());
+    }
+    else
+    {
+      ::tbb::parallel_scan(range, body, ::tbb::auto_partitioner());
+    }
+  }
+};
+
+
+} // end namespace parallelism_detail
+
+
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_for(execution_policy<DerivedPolicy> &exec,
+                  const Range &range,
+                  const Body &body,
+                  partitioner_kind default_kind)
+{
+  const partitioner_kind kind = parallelism_detail::partitioner(exec, default_kind);
+
+  thrust::system::tbb::detail::execute(exec, parallelism_detail::parallel_for_closure<Range,Body>(range, body, kind, get_affinity(thrust::detail::derived_cast(exec))));
+} // end parallel_for()
+
+
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_reduce(execution_policy<DerivedPolicy> &exec,
+                     const Range &range,
+                     Body &body,
+                     partitioner_kind default_kind)
+{
+  const partitioner_kind kind = parallelism_detail::partitioner(exec, default_kind);
+
+  thrust::system::tbb::detail::execute(exec, parallelism_detail::parallel_reduce_closure<Range,Body>(range, body, kind, get_affinity(thrust::detail::derived_cast(exec))));
+} // end parallel_reduce()
+
+
+template<typename DerivedPolicy, typename Range, typename Body>
+void parallel_scan(execution_policy<DerivedPolicy> &exec,
+                   const Range &range,
+                   Body &body,
+                   partitioner_kind default_kind)
+{
+  const partitioner_kind kind = parallelism_detail::partitioner(exec, default_kind);
+
+  thrust::system::tbb::detail::execute(exec, parallelism_detail::parallel_scan_closure<Range,Body>(range, body, kind));
+} // end parallel_scan()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
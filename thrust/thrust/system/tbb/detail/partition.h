@@ -37,6 +37,8 @@ namespace detail
 {
 
 
+// the range is staged through one temporary buffer: a first pass copies it there while
+// counting the selected elements, and a second writes it back in partitioned order
 template<typename DerivedPolicy,
          typename ForwardIterator,
          typename Predicate>
@@ -28,6 +28,8 @@
 #endif // no system header
 #include <thrust/detail/function.h>
 #include <thrust/detail/static_assert.h>
+#include <thrust/detail/seq.h>
+#include <thrust/system/tbb/detail/parallelism.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
 #include <thrust/reduce.h>
@@ -107,7 +109,7 @@ template<typename DerivedPolicy,
          typename InputIterator,
          typename OutputType,
          typename BinaryFunction>
-  OutputType reduce(execution_policy<DerivedPolicy> &,
+  OutputType reduce(execution_policy<DerivedPolicy> &exec,
                     InputIterator begin,
                     InputIterator end,
                     OutputType init,
@@ -121,11 +123,16 @@ template<typename DerivedPolicy,
   {
     return init;
   }
+  else if (thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::reduce(thrust::seq, begin, end, init, binary_op);
+  }
   else
   {
     typedef typename reduce_detail::body<InputIterator,OutputType,BinaryFunction> Body;
     Body reduce_body(begin, init, binary_op);
-    ::tbb::parallel_reduce(::tbb::blocked_range<Size>(0,n), reduce_body);
+    ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+    thrust::system::tbb::detail::parallel_reduce(exec, range, reduce_body);
     return binary_op(init, reduce_body.sum);
   }
 }
@@ -30,6 +30,7 @@
 #include <thrust/detail/seq.h>
 #include <thrust/system/tbb/detail/execution_policy.h>
 #include <thrust/system/tbb/detail/reduce_intervals.h>
+#include <thrust/system/tbb/detail/parallelism.h>
 #include <thrust/detail/minmax.h>
 #include <thrust/detail/temporary_array.h>
 #include <thrust/detail/range/tail_flags.h>
@@ -37,7 +38,6 @@
 #include <tbb/parallel_for.h>
 
 #include <cassert>
-#include <thread>
 
 
 THRUST_NAMESPACE_BEGIN
@@ -279,22 +279,21 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   difference_type n = keys_last - keys_first;
   if(n == 0) return thrust::make_pair(keys_result, values_result);
 
-  // XXX this value is a tuning opportunity
-  const difference_type parallelism_threshold = 10000;
-
-  if(n < parallelism_threshold)
+  if(thrust::system::tbb::detail::run_sequentially(exec, n))
   {
-    // don't bother parallelizing for small n
     return thrust::reduce_by_key(thrust::seq, keys_first, keys_last, values_first, keys_result, values_result, binary_pred, binary_op);
   }
 
-  // count the number of processors
-  const unsigned int p = thrust::max<unsigned int>(1u, std::thread::hardware_concurrency());
+  // XXX this value is a tuning opportunity
+  const difference_type max_interval_size = 10000;
+
+  // count the number of threads available to exec
+  const unsigned int p = thrust::max<unsigned int>(1u, thrust::system::tbb::detail::concurrency(exec));
 
   // generate O(P) intervals of sequential work
   // XXX oversubscribing is a tuning opportunity
   const unsigned int subscription_rate = 1;
-  difference_type interval_size = thrust::min<difference_type>(parallelism_threshold, thrust::max<difference_type>(n, n / (subscription_rate * p)));
+  difference_type interval_size = thrust::min<difference_type>(max_interval_size, thrust::max<difference_type>(n, n / (subscription_rate * p)));
   difference_type num_intervals = reduce_by_key_detail::divide_ri(n, interval_size);
 
   // decompose the input into intervals of size N / num_intervals
@@ -316,10 +315,11 @@ template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typenam
   typedef typename reduce_by_key_detail::partial_sum_type<Iterator2,BinaryFunction>::type carry_type;
   thrust::detail::temporary_array<carry_type, DerivedPolicy> carries(0, exec, num_intervals - 1);
 
-  // force grainsize == 1 with simple_partioner()
-  ::tbb::parallel_for(::tbb::blocked_range<difference_type>(0, num_intervals, 1),
+  // force grainsize == 1 with simple_partioner(), unless exec requests another partitioner
+  thrust::system::tbb::detail::parallel_for(exec,
+    ::tbb::blocked_range<difference_type>(0, num_intervals, 1),
     reduce_by_key_detail::make_serial_reduce_by_key_body(keys_first, values_first, interval_output_offsets.begin(), keys_result, values_result, carries.begin(), n, interval_size, num_intervals, binary_pred, binary_op),
-    ::tbb::simple_partitioner());
+    thrust::system::tbb::partitioner_simple);
 
   difference_type size_of_result = interval_output_offsets[num_intervals];
 
@@ -26,6 +26,7 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/tbb/detail/parallelism.h>
 #include <thrust/detail/seq.h>
 
 #include <tbb/parallel_for.h>
@@ -97,7 +98,7 @@ template<typename RandomAccessIterator1, typename RandomAccessIterator2, typenam
 
 
 template<typename DerivedPolicy, typename RandomAccessIterator1, typename Size, typename RandomAccessIterator2, typename BinaryFunction>
-  void reduce_intervals(thrust::tbb::execution_policy<DerivedPolicy> &,
+  void reduce_intervals(thrust::tbb::execution_policy<DerivedPolicy> &exec,
                         RandomAccessIterator1 first,
                         RandomAccessIterator1 last,
                         Size interval_size,
@@ -108,7 +109,11 @@ template<typename DerivedPolicy, typename RandomAccessIterator1, typename Size,
 
   Size num_intervals = reduce_intervals_detail::divide_ri(n, interval_size);
 
-  ::tbb::parallel_for(::tbb::blocked_range<Size>(0, num_intervals, 1), reduce_intervals_detail::make_body(first, result, Size(n), interval_size, binary_op), ::tbb::simple_partitioner());
+  // each interval is a task of its own unless exec requests another partitioner
+  thrust::system::tbb::detail::parallel_for(exec,
+                                            ::tbb::blocked_range<Size>(0, num_intervals, 1),
+                                            reduce_intervals_detail::make_body(first, result, Size(n), interval_size, binary_op),
+                                            thrust::system::tbb::partitioner_simple);
 }
 
 
@@ -26,7 +26,8 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/tbb/detail/remove.h>
-#include <thrust/system/detail/generic/remove.h>
+#include <thrust/system/tbb/detail/compact.h>
+#include <thrust/detail/internal_functional.h>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -44,8 +45,10 @@ template<typename DerivedPolicy,
                             ForwardIterator last,
                             Predicate pred)
 {
-  // tbb prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, pred);
+  // the elements are inspected before anything is written over them, so first may serve as its own stencil
+  compact_detail::stencil_selector<ForwardIterator,thrust::detail::unary_negate<Predicate> > select(first, thrust::detail::not1(pred));
+
+  return thrust::system::tbb::detail::compact_in_place(exec, first, last, select);
 }
 
 
@@ -59,8 +62,9 @@ template<typename DerivedPolicy,
                             InputIterator stencil,
                             Predicate pred)
 {
-  // tbb prefers generic::remove_if to cpp::remove_if
-  return thrust::system::detail::generic::remove_if(exec, first, last, stencil, pred);
+  compact_detail::stencil_selector<InputIterator,thrust::detail::unary_negate<Predicate> > select(stencil, thrust::detail::not1(pred));
+
+  return thrust::system::tbb::detail::compact_in_place(exec, first, last, select);
 }
 
 
@@ -74,8 +78,9 @@ template<typename DerivedPolicy,
                                 OutputIterator result,
                                 Predicate pred)
 {
-  // tbb prefers generic::remove_copy_if to cpp::remove_copy_if
-  return thrust::system::detail::generic::remove_copy_if(exec, first, last, result, pred);
+  compact_detail::stencil_selector<InputIterator,thrust::detail::unary_negate<Predicate> > select(first, thrust::detail::not1(pred));
+
+  return thrust::system::tbb::detail::compact(exec, first, last, result, select);
 }
 
 template<typename DerivedPolicy,
@@ -90,8 +95,9 @@ template<typename DerivedPolicy,
                                 OutputIterator result,
                                 Predicate pred)
 {
-  // tbb prefers generic::remove_copy_if to cpp::remove_copy_if
-  return thrust::system::detail::generic::remove_copy_if(exec, first, last, stencil, result, pred);
+  compact_detail::stencil_selector<InputIterator2,thrust::detail::unary_negate<Predicate> > select(stencil, thrust::detail::not1(pred));
+
+  return thrust::system::tbb::detail::compact(exec, first, last, result, select);
 }
 
 } // end namespace detail
@@ -26,10 +26,12 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/tbb/detail/scan.h>
+#include <thrust/system/tbb/detail/parallelism.h>
 #include <thrust/distance.h>
-#include <thrust/advance.h>
+#include <thrust/scan.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
 #include <thrust/detail/type_traits.h>
 #include <thrust/detail/type_traits/function_traits.h>
 #include <thrust/detail/type_traits/iterator/is_output_iterator.h>
@@ -200,10 +202,11 @@ struct exclusive_body
 
 } // end scan_detail
 
-template<typename InputIterator,
+template<typename DerivedPolicy,
+         typename InputIterator,
          typename OutputIterator,
          typename BinaryFunction>
-  OutputIterator inclusive_scan(tag,
+  OutputIterator inclusive_scan(execution_policy<DerivedPolicy> &exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -217,23 +220,28 @@ template<typename InputIterator,
   using Size = typename thrust::iterator_difference<InputIterator>::type;
   Size n = thrust::distance(first, last);
 
+  if (thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::inclusive_scan(thrust::seq, first, last, result, binary_op);
+  }
+
   if (n != 0)
   {
     typedef typename scan_detail::inclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, *first);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+    thrust::system::tbb::detail::parallel_scan(exec, range, scan_body);
   }
 
-  thrust::advance(result, n);
-
-  return result;
+  return result + n;
 }
 
-template<typename InputIterator,
+template<typename DerivedPolicy,
+         typename InputIterator,
          typename OutputIterator,
          typename InitialValueType,
          typename BinaryFunction>
-  OutputIterator exclusive_scan(tag,
+  OutputIterator exclusive_scan(execution_policy<DerivedPolicy> &exec,
                                 InputIterator first,
                                 InputIterator last,
                                 OutputIterator result,
@@ -248,16 +256,20 @@ template<typename InputIterator,
   using Size = typename thrust::iterator_difference<InputIterator>::type;
   Size n = thrust::distance(first, last);
 
+  if (thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::exclusive_scan(thrust::seq, first, last, result, init, binary_op);
+  }
+
   if (n != 0)
   {
     typedef typename scan_detail::exclusive_body<InputIterator,OutputIterator,BinaryFunction,ValueType> Body;
     Body scan_body(first, result, binary_op, init);
-    ::tbb::parallel_scan(::tbb::blocked_range<Size>(0,n), scan_body);
+    ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+    thrust::system::tbb::detail::parallel_scan(exec, range, scan_body);
   }
 
-  thrust::advance(result, n);
-
-  return result;
+  return result + n;
 }
 
 } // end namespace detail
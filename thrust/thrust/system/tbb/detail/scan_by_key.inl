@@ -0,0 +1,419 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/scan_by_key.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/scan.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace scan_by_key_detail
+{
+
+// the state of a body summarizes the range it has consumed so far as
+// (first_key, last_key, has_head, sum), where has_head records whether a
+// segment begins after first_key and sum is the sum of the last, possibly
+// unfinished, segment. the keys at the boundary between two summaries are
+// compared when they are joined, so bodies never read keys outside of their
+// ranges, which permits the output to alias the keys
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename KeyType,
+         typename ValueType>
+struct inclusive_body
+{
+  InputIterator1 keys;
+  InputIterator2 values;
+  OutputIterator output;
+  thrust::detail::wrapped_function<BinaryPredicate,bool> binary_pred;
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> binary_op;
+  KeyType first_key;
+  KeyType last_key;
+  ValueType sum;
+  bool has_head;
+  bool first_call;
+
+  // note: we only initialize the keys and sum with dummies to avoid calling their default constructors
+  inclusive_body(InputIterator1 keys, InputIterator2 values, OutputIterator output, BinaryPredicate binary_pred, BinaryFunction binary_op, KeyType dummy_key, ValueType dummy_value)
+    : keys(keys), values(values), output(output), binary_pred(binary_pred), binary_op(binary_op),
+      first_key(dummy_key), last_key(dummy_key), sum(dummy_value), has_head(false), first_call(true)
+  {}
+
+  inclusive_body(inclusive_body& b, ::tbb::split)
+    : keys(b.keys), values(b.values), output(b.output), binary_pred(b.binary_pred), binary_op(b.binary_op),
+      first_key(b.first_key), last_key(b.last_key), sum(b.sum), has_head(false), first_call(true)
+  {}
+
+  template<typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  {
+    InputIterator1 iter1 = keys   + r.begin();
+    InputIterator2 iter2 = values + r.begin();
+
+    Size i = r.begin();
+
+    if (first_call)
+    {
+      first_key = last_key = *iter1;
+      sum = *iter2;
+      ++i, ++iter1, ++iter2;
+    }
+
+    for (; i != r.end(); ++i, ++iter1, ++iter2)
+    {
+      KeyType key = *iter1;
+
+      if (binary_pred(last_key, key))
+      {
+        sum = binary_op(sum, *iter2);
+      }
+      else
+      {
+        sum = *iter2;
+        has_head = true;
+      }
+
+      last_key = key;
+    }
+
+    first_call = false;
+  }
+
+  template<typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
+  {
+    InputIterator1 iter1 = keys   + r.begin();
+    InputIterator2 iter2 = values + r.begin();
+    OutputIterator iter3 = output + r.begin();
+
+    Size i = r.begin();
+
+    if (first_call)
+    {
+      // only the body which begins the input has no carry
+      first_key = last_key = *iter1;
+      *iter3 = sum = *iter2;
+      ++i, ++iter1, ++iter2, ++iter3;
+    }
+
+    for (; i != r.end(); ++i, ++iter1, ++iter2, ++iter3)
+    {
+      KeyType key = *iter1;
+
+      if (binary_pred(last_key, key))
+      {
+        *iter3 = sum = binary_op(sum, *iter2);
+      }
+      else
+      {
+        *iter3 = sum = *iter2;
+        has_head = true;
+      }
+
+      last_key = key;
+    }
+
+    first_call = false;
+  }
+
+  void reverse_join(inclusive_body& b)
+  {
+    // if this functor has not been called, simply adopt the summary of b
+    if (first_call)
+    {
+      assign(b);
+      return;
+    }
+
+    const bool boundary_is_head = !binary_pred(b.last_key, first_key);
+
+    if (!has_head && !boundary_is_head)
+    {
+      sum = binary_op(b.sum, sum);
+    }
+
+    has_head  = b.has_head || boundary_is_head || has_head;
+    first_key = b.first_key;
+  }
+
+  void assign(inclusive_body& b)
+  {
+    first_key  = b.first_key;
+    last_key   = b.last_key;
+    sum        = b.sum;
+    has_head   = b.has_head;
+    first_call = b.first_call;
+  }
+};
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction,
+         typename KeyType,
+         typename ValueType>
+struct exclusive_body
+{
+  InputIterator1 keys;
+  InputIterator2 values;
+  OutputIterator output;
+  thrust::detail::wrapped_function<BinaryPredicate,bool> binary_pred;
+  thrust::detail::wrapped_function<BinaryFunction,ValueType> binary_op;
+  ValueType init;
+  KeyType first_key;
+  KeyType last_key;
+  ValueType sum; // seeded with init only when has_head or the range begins the input
+  bool has_head;
+  bool first_call;
+
+  // note: we only initialize the keys with a dummy to avoid calling KeyType's default constructor
+  exclusive_body(InputIterator1 keys, InputIterator2 values, OutputIterator output, BinaryPredicate binary_pred, BinaryFunction binary_op, KeyType dummy_key, ValueType init)
+    : keys(keys), values(values), output(output), binary_pred(binary_pred), binary_op(binary_op),
+      init(init), first_key(dummy_key), last_key(dummy_key), sum(init), has_head(false), first_call(true)
+  {}
+
+  exclusive_body(exclusive_body& b, ::tbb::split)
+    : keys(b.keys), values(b.values), output(b.output), binary_pred(b.binary_pred), binary_op(b.binary_op),
+      init(b.init), first_key(b.first_key), last_key(b.last_key), sum(b.init), has_head(false), first_call(true)
+  {}
+
+  template<typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::pre_scan_tag)
+  {
+    InputIterator1 iter1 = keys   + r.begin();
+    InputIterator2 iter2 = values + r.begin();
+
+    Size i = r.begin();
+
+    if (first_call)
+    {
+      first_key = last_key = *iter1;
+
+      // the range which begins the input also begins a segment
+      ValueType value = *iter2;
+      has_head = (r.begin() == 0);
+      sum = has_head ? binary_op(init, value) : value;
+
+      ++i, ++iter1, ++iter2;
+    }
+
+    for (; i != r.end(); ++i, ++iter1, ++iter2)
+    {
+      KeyType key = *iter1;
+      ValueType value = *iter2;
+
+      if (binary_pred(last_key, key))
+      {
+        sum = binary_op(sum, value);
+      }
+      else
+      {
+        sum = binary_op(init, value);
+        has_head = true;
+      }
+
+      last_key = key;
+    }
+
+    first_call = false;
+  }
+
+  template<typename Size>
+  void operator()(const ::tbb::blocked_range<Size>& r, ::tbb::final_scan_tag)
+  {
+    InputIterator1 iter1 = keys   + r.begin();
+    InputIterator2 iter2 = values + r.begin();
+    OutputIterator iter3 = output + r.begin();
+
+    Size i = r.begin();
+
+    if (first_call)
+    {
+      // only the body which begins the input has no carry
+      first_key = last_key = *iter1;
+
+      ValueType value = *iter2; // use temp to permit in-place scans
+      *iter3 = init;
+      sum = binary_op(init, value);
+      has_head = true;
+
+      ++i, ++iter1, ++iter2, ++iter3;
+    }
+
+    for (; i != r.end(); ++i, ++iter1, ++iter2, ++iter3)
+    {
+      KeyType key = *iter1;
+      ValueType value = *iter2; // use temp to permit in-place scans
+
+      if (!binary_pred(last_key, key))
+      {
+        sum = init; // reset sum
+        has_head = true;
+      }
+
+      *iter3 = sum;
+      sum = binary_op(sum, value);
+
+      last_key = key;
+    }
+
+    first_call = false;
+  }
+
+  void reverse_join(exclusive_body& b)
+  {
+    // if this functor has not been called, simply adopt the summary of b
+    if (first_call)
+    {
+      assign(b);
+      return;
+    }
+
+    const bool boundary_is_head = !binary_pred(b.last_key, first_key);
+
+    if (!has_head)
+    {
+      sum = boundary_is_head ? binary_op(init, sum) : binary_op(b.sum, sum);
+    }
+
+    has_head  = b.has_head || boundary_is_head || has_head;
+    first_key = b.first_key;
+  }
+
+  void assign(exclusive_body& b)
+  {
+    first_key  = b.first_key;
+    last_key   = b.last_key;
+    sum        = b.sum;
+    has_head   = b.has_head;
+    first_call = b.first_call;
+  }
+};
+
+} // end scan_by_key_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator inclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  using KeyType   = typename thrust::iterator_value<InputIterator1>::type;
+  using ValueType = typename thrust::iterator_value<InputIterator2>::type;
+
+  using Size = typename thrust::iterator_difference<InputIterator1>::type;
+  Size n = thrust::distance(first1, last1);
+
+  if (thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::inclusive_scan_by_key(thrust::seq, first1, last1, first2, result, binary_pred, binary_op);
+  }
+
+  if (n != 0)
+  {
+    typedef typename scan_by_key_detail::inclusive_body<InputIterator1,InputIterator2,OutputIterator,BinaryPredicate,BinaryFunction,KeyType,ValueType> Body;
+    Body scan_body(first1, first2, result, binary_pred, binary_op, *first1, *first2);
+    ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+    thrust::system::tbb::detail::parallel_scan(exec, range, scan_body);
+  }
+
+  thrust::advance(result, n);
+
+  return result;
+}
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename T,
+         typename BinaryPredicate,
+         typename BinaryFunction>
+  OutputIterator exclusive_scan_by_key(execution_policy<DerivedPolicy> &exec,
+                                       InputIterator1 first1,
+                                       InputIterator1 last1,
+                                       InputIterator2 first2,
+                                       OutputIterator result,
+                                       T init,
+                                       BinaryPredicate binary_pred,
+                                       BinaryFunction binary_op)
+{
+  using KeyType   = typename thrust::iterator_value<InputIterator1>::type;
+  using ValueType = T;
+
+  using Size = typename thrust::iterator_difference<InputIterator1>::type;
+  Size n = thrust::distance(first1, last1);
+
+  if (thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::exclusive_scan_by_key(thrust::seq, first1, last1, first2, result, init, binary_pred, binary_op);
+  }
+
+  if (n != 0)
+  {
+    typedef typename scan_by_key_detail::exclusive_body<InputIterator1,InputIterator2,OutputIterator,BinaryPredicate,BinaryFunction,KeyType,ValueType> Body;
+    Body scan_body(first1, first2, result, binary_pred, binary_op, *first1, init);
+    ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+    thrust::system::tbb::detail::parallel_scan(exec, range, scan_body);
+  }
+
+  thrust::advance(result, n);
+
+  return result;
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
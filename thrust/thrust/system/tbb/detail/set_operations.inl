@@ -0,0 +1,315 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/set_operations.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/merge_path.h>
+#include <thrust/system/detail/internal/set_operations.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/distance.h>
+#include <thrust/scan.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+
+// every set operation proceeds in three passes over tiles of the merge of both input ranges:
+//   1. each tile boundary is located along the merge path and moved back to the start of
+//      its run of equivalent elements, so that each tile holds every copy of its elements
+//   2. each tile performs its set operation sequentially, only counting its output
+//   3. the counts are scanned into output offsets, and each tile performs its set
+//      operation again, writing its output at its offset
+
+
+template<typename InputIterator1,
+         typename InputIterator2,
+         typename Size,
+         typename StrictWeakOrdering>
+struct partition_body
+{
+  InputIterator1 first1;
+  Size n1;
+  InputIterator2 first2;
+  Size n2;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &decomp;
+  Size *splits1;
+  Size *splits2;
+  StrictWeakOrdering comp;
+
+  partition_body(InputIterator1 first1, Size n1,
+                 InputIterator2 first2, Size n2,
+                 const thrust::system::detail::internal::uniform_decomposition<Size> &decomp,
+                 Size *splits1, Size *splits2,
+                 StrictWeakOrdering comp)
+    : first1(first1), n1(n1), first2(first2), n2(n2),
+      decomp(decomp), splits1(splits1), splits2(splits2), comp(comp)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      thrust::pair<Size,Size> split =
+        thrust::system::detail::internal::run_aligned_merge_path(first1, n1, first2, n2, decomp[i].begin(), comp);
+
+      splits1[i] = split.first;
+      splits2[i] = split.second;
+    }
+  }
+};
+
+
+// counts the output of each tile, or writes it at result + offsets[i] once the counts are scanned
+template<bool CountOnly,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename Size,
+         typename StrictWeakOrdering,
+         typename SetOperation>
+struct set_operation_body
+{
+  InputIterator1 first1;
+  InputIterator2 first2;
+  OutputIterator result;
+  const Size *splits1;
+  const Size *splits2;
+  Size *offsets;
+  StrictWeakOrdering comp;
+  SetOperation set_op;
+
+  set_operation_body(InputIterator1 first1,
+                     InputIterator2 first2,
+                     OutputIterator result,
+                     const Size *splits1, const Size *splits2,
+                     Size *offsets,
+                     StrictWeakOrdering comp,
+                     SetOperation set_op)
+    : first1(first1), first2(first2), result(result),
+      splits1(splits1), splits2(splits2), offsets(offsets),
+      comp(comp), set_op(set_op)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      if(CountOnly)
+      {
+        thrust::discard_iterator<> counter;
+
+        offsets[i] = set_op(first1 + splits1[i], first1 + splits1[i + 1],
+                            first2 + splits2[i], first2 + splits2[i + 1],
+                            counter,
+                            comp) - counter;
+      }
+      else
+      {
+        set_op(first1 + splits1[i], first1 + splits1[i + 1],
+               first2 + splits2[i], first2 + splits2[i + 1],
+               result + offsets[i],
+               comp);
+      }
+    }
+  }
+};
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering,
+         typename SetOperation>
+  OutputIterator set_operation(execution_policy<DerivedPolicy> &exec,
+                               InputIterator1 first1,
+                               InputIterator1 last1,
+                               InputIterator2 first2,
+                               InputIterator2 last2,
+                               OutputIterator result,
+                               StrictWeakOrdering comp,
+                               SetOperation set_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator1>::type difference_type;
+
+  const difference_type n1 = thrust::distance(first1, last1);
+  const difference_type n2 = thrust::distance(first2, last2);
+
+  if(n1 + n2 == 0) return result;
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, n1 + n2))
+  {
+    return set_op(first1, last1, first2, last2, result, comp);
+  }
+
+  // one tile per thread of exec's arena
+  const difference_type p = thrust::max<difference_type>(1, thrust::system::tbb::detail::concurrency(exec));
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> decomp(n1 + n2, 1, p);
+
+  const difference_type num_tiles = decomp.size();
+
+  // tile i covers [splits1[i], splits1[i + 1]) and [splits2[i], splits2[i + 1]),
+  // and its output begins at offsets[i]
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> splits1(exec, num_tiles + 1);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> splits2(exec, num_tiles + 1);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> offsets(exec, num_tiles + 1);
+
+  difference_type *splits1_ptr = thrust::raw_pointer_cast(splits1.data());
+  difference_type *splits2_ptr = thrust::raw_pointer_cast(splits2.data());
+  difference_type *offsets_ptr = thrust::raw_pointer_cast(offsets.data());
+
+  // wrap comp
+  typedef thrust::detail::wrapped_function<StrictWeakOrdering,bool> wrapped_comp_type;
+  wrapped_comp_type wrapped_comp(comp);
+
+  ::tbb::blocked_range<difference_type> tiles(0, num_tiles, 1);
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, partition_body<InputIterator1,InputIterator2,difference_type,wrapped_comp_type>(first1, n1, first2, n2, decomp, splits1_ptr, splits2_ptr, wrapped_comp));
+
+  splits1_ptr[num_tiles] = n1;
+  splits2_ptr[num_tiles] = n2;
+
+  typedef set_operation_body<
+    true, InputIterator1, InputIterator2, OutputIterator,
+    difference_type, wrapped_comp_type, SetOperation
+  > count_body;
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, count_body(first1, first2, result, splits1_ptr, splits2_ptr, offsets_ptr, wrapped_comp, set_op));
+
+  // offsets[num_tiles] becomes the size of the output
+  offsets_ptr[num_tiles] = 0;
+  thrust::exclusive_scan(thrust::seq, offsets_ptr, offsets_ptr + num_tiles + 1, offsets_ptr);
+
+  typedef set_operation_body<
+    false, InputIterator1, InputIterator2, OutputIterator,
+    difference_type, wrapped_comp_type, SetOperation
+  > write_body;
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, write_body(first1, first2, result, splits1_ptr, splits2_ptr, offsets_ptr, wrapped_comp, set_op));
+
+  return result + offsets_ptr[num_tiles];
+} // end set_operation()
+
+
+} // end namespace set_operations_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_difference(execution_policy<DerivedPolicy> &exec,
+                                InputIterator1 first1,
+                                InputIterator1 last1,
+                                InputIterator2 first2,
+                                InputIterator2 last2,
+                                OutputIterator result,
+                                StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_operations_detail::serial_set_difference());
+} // end set_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_intersection(execution_policy<DerivedPolicy> &exec,
+                                  InputIterator1 first1,
+                                  InputIterator1 last1,
+                                  InputIterator2 first2,
+                                  InputIterator2 last2,
+                                  OutputIterator result,
+                                  StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_operations_detail::serial_set_intersection());
+} // end set_intersection()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_symmetric_difference(execution_policy<DerivedPolicy> &exec,
+                                          InputIterator1 first1,
+                                          InputIterator1 last1,
+                                          InputIterator2 first2,
+                                          InputIterator2 last2,
+                                          OutputIterator result,
+                                          StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_operations_detail::serial_set_symmetric_difference());
+} // end set_symmetric_difference()
+
+
+template<typename DerivedPolicy,
+         typename InputIterator1,
+         typename InputIterator2,
+         typename OutputIterator,
+         typename StrictWeakOrdering>
+  OutputIterator set_union(execution_policy<DerivedPolicy> &exec,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           InputIterator2 last2,
+                           OutputIterator result,
+                           StrictWeakOrdering comp)
+{
+  return set_operations_detail::set_operation(exec, first1, last1, first2, last2, result, comp,
+                                              thrust::system::detail::internal::set_operations_detail::serial_set_union());
+} // end set_union()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
+
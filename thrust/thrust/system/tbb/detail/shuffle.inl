@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/shuffle.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/shuffle.h>
+#include <thrust/shuffle.h>
+#include <thrust/system/detail/generic/shuffle.h>
+#include <thrust/detail/temporary_array.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <tbb/blocked_range.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace shuffle_detail
+{
+
+
+template<typename Size>
+struct count_body
+{
+  const thrust::system::detail::internal::bucket_shuffle &shuffler;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &blocks;
+  Size *counts;
+
+  count_body(const thrust::system::detail::internal::bucket_shuffle &shuffler,
+             const thrust::system::detail::internal::uniform_decomposition<Size> &blocks,
+             Size *counts)
+    : shuffler(shuffler), blocks(blocks), counts(counts)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      thrust::system::detail::internal::count_buckets(shuffler, blocks[i].begin(), blocks[i].end(), counts + i * static_cast<Size>(shuffler.num_buckets()));
+    }
+  }
+}; // end count_body
+
+
+template<typename RandomIterator, typename T, typename Size>
+struct scatter_body
+{
+  const thrust::system::detail::internal::bucket_shuffle &shuffler;
+  const thrust::system::detail::internal::uniform_decomposition<Size> &blocks;
+  RandomIterator first;
+  T *buffer;
+  Size *positions;
+
+  scatter_body(const thrust::system::detail::internal::bucket_shuffle &shuffler,
+               const thrust::system::detail::internal::uniform_decomposition<Size> &blocks,
+               RandomIterator first,
+               T *buffer,
+               Size *positions)
+    : shuffler(shuffler), blocks(blocks), first(first), buffer(buffer), positions(positions)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size i = r.begin(); i < r.end(); ++i)
+    {
+      thrust::system::detail::internal::scatter_buckets(shuffler, first, blocks[i].begin(), blocks[i].end(), buffer, positions + i * static_cast<Size>(shuffler.num_buckets()));
+    }
+  }
+}; // end scatter_body
+
+
+template<typename T, typename Size, typename OutputIterator>
+struct bucket_body
+{
+  const thrust::system::detail::internal::bucket_shuffle &shuffler;
+  T *buffer;
+  const Size *bucket_begin;
+  OutputIterator result;
+
+  bucket_body(const thrust::system::detail::internal::bucket_shuffle &shuffler,
+              T *buffer,
+              const Size *bucket_begin,
+              OutputIterator result)
+    : shuffler(shuffler), buffer(buffer), bucket_begin(bucket_begin), result(result)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    for(Size b = r.begin(); b < r.end(); ++b)
+    {
+      thrust::system::detail::internal::shuffle_bucket(shuffler, buffer, bucket_begin, b, result);
+    }
+  }
+}; // end bucket_body
+
+
+// below the sequential cutoff, the calling thread makes the same permutation alone
+template<typename DerivedPolicy, typename Size, typename Body>
+void for_each_block(execution_policy<DerivedPolicy> &exec, bool sequential, Size num_blocks, const Body &body)
+{
+  ::tbb::blocked_range<Size> range(0, num_blocks, 1);
+
+  if(sequential)
+  {
+    body(range);
+  }
+  else
+  {
+    thrust::system::tbb::detail::parallel_for(exec, range, body);
+  }
+}
+
+
+} // end shuffle_detail
+
+
+template<typename DerivedPolicy, typename RandomIterator, typename URBG>
+  void shuffle(execution_policy<DerivedPolicy> &exec,
+               RandomIterator first,
+               RandomIterator last,
+               URBG &&g)
+{
+  typedef typename thrust::iterator_value<RandomIterator>::type InputType;
+
+  // the generic shuffle_copy may not write to its input, so the generic shuffle copies it first
+  if(static_cast<std::uint64_t>(thrust::distance(first, last)) <= thrust::system::detail::internal::shuffle_bucket_size(sizeof(InputType)))
+  {
+    thrust::system::detail::generic::shuffle(exec, first, last, g);
+    return;
+  }
+
+  // every element is read into the buffer before any is written back
+  thrust::system::tbb::detail::shuffle_copy(exec, first, last, first, g);
+} // end shuffle()
+
+
+template<typename DerivedPolicy, typename RandomIterator, typename OutputIterator, typename URBG>
+  void shuffle_copy(execution_policy<DerivedPolicy> &exec,
+                    RandomIterator first,
+                    RandomIterator last,
+                    OutputIterator result,
+                    URBG &&g)
+{
+  typedef typename thrust::iterator_value<RandomIterator>::type      InputType;
+  typedef typename thrust::iterator_difference<RandomIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0) return;
+
+  // a single bucket would be shuffled by one thread, while the Feistel bijection
+  // of the generic shuffle permutes it in parallel
+  const std::uint64_t bucket_size = thrust::system::detail::internal::shuffle_bucket_size(sizeof(InputType));
+
+  if(static_cast<std::uint64_t>(n) <= bucket_size)
+  {
+    thrust::system::detail::generic::shuffle_copy(exec, first, last, result, g);
+    return;
+  }
+
+  thrust::system::detail::internal::bucket_shuffle shuffler(n, bucket_size, g);
+
+  const difference_type num_buckets = static_cast<difference_type>(shuffler.num_buckets());
+  const difference_type num_blocks  = static_cast<difference_type>(shuffler.num_blocks());
+
+  thrust::system::detail::internal::uniform_decomposition<difference_type> blocks(n, 1, num_blocks);
+
+  // row i of counts holds the counts of block i
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> counts(exec, num_blocks * num_buckets);
+  thrust::detail::temporary_array<difference_type,DerivedPolicy> bucket_begin(exec, num_buckets + 1);
+  thrust::detail::temporary_array<InputType,DerivedPolicy>       buffer(exec, n);
+
+  difference_type *counts_ptr       = thrust::raw_pointer_cast(counts.data());
+  difference_type *bucket_begin_ptr = thrust::raw_pointer_cast(bucket_begin.data());
+  InputType       *buffer_ptr       = thrust::raw_pointer_cast(buffer.data());
+
+  const bool sequential = thrust::system::tbb::detail::run_sequentially(exec, n);
+
+  shuffle_detail::for_each_block(exec, sequential, num_blocks, shuffle_detail::count_body<difference_type>(shuffler, blocks, counts_ptr));
+
+  thrust::system::detail::internal::scan_buckets(shuffler, counts_ptr, bucket_begin_ptr);
+
+  shuffle_detail::for_each_block(exec, sequential, num_blocks, shuffle_detail::scatter_body<RandomIterator,InputType,difference_type>(shuffler, blocks, first, buffer_ptr, counts_ptr));
+
+  shuffle_detail::for_each_block(exec, sequential, num_buckets, shuffle_detail::bucket_body<InputType,difference_type,OutputIterator>(shuffler, buffer_ptr, bucket_begin_ptr, result));
+} // end shuffle_copy()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
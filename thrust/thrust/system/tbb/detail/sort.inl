@@ -27,12 +27,28 @@
 #endif // no system header
 #include <thrust/detail/temporary_array.h>
 #include <thrust/detail/copy.h>
+#include <thrust/uninitialized_copy.h>
 #include <thrust/iterator/iterator_traits.h>
 #include <thrust/distance.h>
+#include <thrust/gather.h>
 #include <thrust/merge.h>
+#include <thrust/sequence.h>
 #include <thrust/sort.h>
 #include <thrust/detail/seq.h>
-#include <tbb/parallel_invoke.h>
+#include <thrust/detail/minmax.h>
+#include <thrust/detail/type_traits.h>
+#include <thrust/detail/raw_pointer_cast.h>
+#include <thrust/system/detail/internal/cache_size.h>
+#include <thrust/system/detail/internal/decompose.h>
+#include <thrust/system/detail/internal/index_sort.h>
+#include <thrust/system/detail/internal/radix_sort.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
 
 THRUST_NAMESPACE_BEGIN
 namespace system
@@ -45,184 +61,549 @@ namespace sort_detail
 {
 
 
-// TODO tune this based on data type and comp
-const static int threshold = 128 * 1024;
+// the merge sort cuts its input into a power of two of leaves and merges them pairwise
+// along a complete binary tree:
+//   1. every leaf is stable sorted sequentially by a task of a parallel loop
+//   2. the task which completes the second child of a node goes on to merge the node,
+//      and so on towards the root
+// a merge thus starts as soon as both of its inputs are ready, rather than once every
+// subtree of its level has been merged, and no thread waits on a slow sibling
+// the merges ping-pong between the input and a single buffer; the leaves are sorted in
+// whichever of the two makes the root land in the input, and a leaf is copied into the
+// buffer only to be sorted there or to construct values which are not trivially copyable
 
 
-template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace);
+// a leaf and its share of the buffer should stay in a core's cache while it is sorted, so
+// the leaves span about half of the cache, whatever the size of their elements
+inline std::size_t leaf_bytes()
+{
+  return thrust::system::detail::internal::cache_size() / 2;
+}
+
+
+// the smallest power of two of leaves of at most leaf_bytes() each covering n elements of
+// the given size, but no more leaves than elements, so that every leaf is non-empty
+template<typename IndexType>
+IndexType num_leaves(IndexType n, std::size_t element_size)
+{
+  const IndexType leaf_size = thrust::max<IndexType>(1, static_cast<IndexType>(leaf_bytes() / element_size));
+
+  IndexType result = 1;
 
+  while(2 * result <= n && result * leaf_size < n)
+  {
+    result *= 2;
+  }
+
+  return result;
+}
 
+
+// sorts and merges keys
 template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-struct merge_sort_closure
+struct merge_sort_keys
 {
   execution_policy<DerivedPolicy> &exec;
-  Iterator1 first1, last1;
-  Iterator2 first2;
+  Iterator1 first;
+  Iterator2 buffer;
   StrictWeakOrdering comp;
-  bool inplace;
 
-  merge_sort_closure(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace)
-    : exec(exec), first1(first1), last1(last1), first2(first2), comp(comp), inplace(inplace)
+  merge_sort_keys(execution_policy<DerivedPolicy> &exec, Iterator1 first, Iterator2 buffer, StrictWeakOrdering comp)
+    : exec(exec), first(first), buffer(buffer), comp(comp)
   {}
 
-  void operator()(void) const
+  template<typename IndexType>
+  void sort(IndexType begin, IndexType end, bool in_buffer) const
   {
-    merge_sort(exec, first1, last1, first2, comp, inplace);
+    typedef typename thrust::iterator_value<Iterator1>::type key_type;
+
+    if(in_buffer || !thrust::detail::has_trivial_copy_constructor<key_type>::value)
+    {
+      thrust::uninitialized_copy(thrust::seq, first + begin, first + end, buffer + begin);
+    }
+
+    if(in_buffer) thrust::stable_sort(thrust::seq, buffer + begin, buffer + end, comp);
+    else          thrust::stable_sort(thrust::seq, first + begin, first + end, comp);
+  }
+
+  template<typename IndexType>
+  void merge(IndexType begin, IndexType mid, IndexType end, bool into_buffer) const
+  {
+    if(into_buffer) thrust::merge(exec, first + begin, first + mid, first + mid, first + end, buffer + begin, comp);
+    else            thrust::merge(exec, buffer + begin, buffer + mid, buffer + mid, buffer + end, first + begin, comp);
   }
 };
 
 
-template<typename DerivedPolicy, typename Iterator1, typename Iterator2, typename StrictWeakOrdering>
-void merge_sort(execution_policy<DerivedPolicy> &exec, Iterator1 first1, Iterator1 last1, Iterator2 first2, StrictWeakOrdering comp, bool inplace)
+// sorts and merges keys along with their values
+template<typename DerivedPolicy,
+         typename Iterator1,
+         typename Iterator2,
+         typename Iterator3,
+         typename Iterator4,
+         typename StrictWeakOrdering>
+struct merge_sort_pairs
 {
-  typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
+  execution_policy<DerivedPolicy> &exec;
+  Iterator1 keys_first;
+  Iterator2 values_first;
+  Iterator3 keys_buffer;
+  Iterator4 values_buffer;
+  StrictWeakOrdering comp;
 
-  difference_type n = thrust::distance(first1, last1);
+  merge_sort_pairs(execution_policy<DerivedPolicy> &exec,
+                   Iterator1 keys_first,
+                   Iterator2 values_first,
+                   Iterator3 keys_buffer,
+                   Iterator4 values_buffer,
+                   StrictWeakOrdering comp)
+    : exec(exec), keys_first(keys_first), values_first(values_first),
+      keys_buffer(keys_buffer), values_buffer(values_buffer), comp(comp)
+  {}
 
-  if (n < threshold)
+  template<typename IndexType>
+  void sort(IndexType begin, IndexType end, bool in_buffer) const
   {
-    thrust::stable_sort(thrust::seq, first1, last1, comp);
+    typedef typename thrust::iterator_value<Iterator1>::type key_type;
+    typedef typename thrust::iterator_value<Iterator2>::type val_type;
 
-    if(!inplace)
+    if(in_buffer || !thrust::detail::has_trivial_copy_constructor<key_type>::value)
     {
-      thrust::copy(thrust::seq, first1, last1, first2);
+      thrust::uninitialized_copy(thrust::seq, keys_first + begin, keys_first + end, keys_buffer + begin);
     }
 
-    return;
+    if(in_buffer || !thrust::detail::has_trivial_copy_constructor<val_type>::value)
+    {
+      thrust::uninitialized_copy(thrust::seq, values_first + begin, values_first + end, values_buffer + begin);
+    }
+
+    if(in_buffer) thrust::stable_sort_by_key(thrust::seq, keys_buffer + begin, keys_buffer + end, values_buffer + begin, comp);
+    else          thrust::stable_sort_by_key(thrust::seq, keys_first + begin, keys_first + end, values_first + begin, comp);
   }
 
-  Iterator1 mid1  = first1 + (n / 2);
-  Iterator2 mid2  = first2 + (n / 2);
-  Iterator2 last2 = first2 + n;
+  template<typename IndexType>
+  void merge(IndexType begin, IndexType mid, IndexType end, bool into_buffer) const
+  {
+    if(into_buffer)
+    {
+      thrust::merge_by_key(exec,
+                           keys_first + begin, keys_first + mid,
+                           keys_first + mid,   keys_first + end,
+                           values_first + begin, values_first + mid,
+                           keys_buffer + begin, values_buffer + begin,
+                           comp);
+    }
+    else
+    {
+      thrust::merge_by_key(exec,
+                           keys_buffer + begin, keys_buffer + mid,
+                           keys_buffer + mid,   keys_buffer + end,
+                           values_buffer + begin, values_buffer + mid,
+                           keys_first + begin, values_first + begin,
+                           comp);
+    }
+  }
+};
 
-  typedef merge_sort_closure<DerivedPolicy,Iterator1,Iterator2,StrictWeakOrdering> Closure;
 
-  Closure left (exec, first1, mid1,  first2, comp, !inplace);
-  Closure right(exec, mid1,   last1, mid2,   comp, !inplace);
+template<typename Sorter, typename IndexType>
+struct merge_sort_body
+{
+  const Sorter &sorter;
+  const thrust::system::detail::internal::uniform_decomposition<IndexType> &leaves;
+  IndexType depth;
+
+  // arrivals[(leaves.size() >> level) + i] counts the completed children of the i-th node
+  // of the given level; the root is arrivals[1]
+  std::atomic<int> *arrivals;
+
+  merge_sort_body(const Sorter &sorter,
+                  const thrust::system::detail::internal::uniform_decomposition<IndexType> &leaves,
+                  IndexType depth,
+                  std::atomic<int> *arrivals)
+    : sorter(sorter), leaves(leaves), depth(depth), arrivals(arrivals)
+  {}
 
-  ::tbb::parallel_invoke(left, right);
+  void operator()(const ::tbb::blocked_range<IndexType> &r) const
+  {
+    for(IndexType leaf = r.begin(); leaf < r.end(); ++leaf)
+    {
+      // an odd number of levels starts from the buffer
+      sorter.sort(leaves[leaf].begin(), leaves[leaf].end(), depth % 2 != 0);
 
-  if(inplace) thrust::merge(exec, first2, mid2, mid2, last2, first1, comp);
-  else	      thrust::merge(exec, first1, mid1, mid1, last1, first2, comp);
-}
+      IndexType node = leaf;
 
+      for(IndexType level = 1; level <= depth; ++level)
+      {
+        node /= 2;
 
-} // end namespace sort_detail
+        // the first child to complete leaves the merge to the second
+        if(arrivals[(leaves.size() >> level) + node].fetch_add(1) == 0) break;
 
+        const IndexType first_leaf = node << level;
+        const IndexType last_leaf  = first_leaf + (IndexType(1) << level) - 1;
+        const IndexType mid_leaf   = first_leaf + (IndexType(1) << (level - 1));
 
-namespace sort_by_key_detail
+        // the root is merged into the input
+        sorter.merge(leaves[first_leaf].begin(), leaves[mid_leaf].begin(), leaves[last_leaf].end(), (depth - level) % 2 != 0);
+      }
+    }
+  }
+};
+
+
+template<typename DerivedPolicy, typename Sorter, typename IndexType>
+void merge_sort(execution_policy<DerivedPolicy> &exec, const Sorter &sorter, IndexType n, std::size_t element_size)
 {
+  const IndexType num_leaves = sort_detail::num_leaves(n, element_size);
 
+  thrust::system::detail::internal::uniform_decomposition<IndexType> leaves(n, 1, num_leaves);
 
-// TODO tune this based on data type and comp
-const static int threshold = 128 * 1024;
+  IndexType depth = 0;
+
+  while((IndexType(1) << depth) < leaves.size())
+  {
+    ++depth;
+  }
+
+  std::unique_ptr<std::atomic<int>[]> arrivals(new std::atomic<int>[leaves.size()]());
+
+  ::tbb::blocked_range<IndexType> range(0, leaves.size(), 1);
+
+  thrust::system::tbb::detail::parallel_for(exec, range, merge_sort_body<Sorter,IndexType>(sorter, leaves, depth, arrivals.get()));
+}
 
 
 template<typename DerivedPolicy,
-         typename Iterator1,
-         typename Iterator2,
-         typename Iterator3,
-         typename Iterator4,
+         typename RandomAccessIterator,
          typename StrictWeakOrdering>
-void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
-                       Iterator1 first1,
-                       Iterator1 last1,
-                       Iterator2 first2,
-                       Iterator3 first3,
-                       Iterator4 first4,
-                       StrictWeakOrdering comp,
-                       bool inplace);
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::false_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+
+  // below the sequential cutoff, the input is a single leaf which is never merged, so it is
+  // sorted as the leaves are without allocating the buffer
+  if(thrust::system::tbb::detail::run_sequentially(exec, thrust::distance(first, last)))
+  {
+    thrust::stable_sort(thrust::seq, first, last, comp);
+    return;
+  }
+
+  // the ping-pong buffer, filled by the leaves
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp(0, exec, thrust::distance(first, last));
+
+  typedef merge_sort_keys<DerivedPolicy,RandomAccessIterator,typename thrust::detail::temporary_array<key_type, DerivedPolicy>::iterator,StrictWeakOrdering> Sorter;
+
+  merge_sort(exec, Sorter(exec, first, temp.begin(), comp), thrust::distance(first, last), sizeof(key_type));
+}
 
 
 template<typename DerivedPolicy,
-         typename Iterator1,
-         typename Iterator2,
-         typename Iterator3,
-         typename Iterator4,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
          typename StrictWeakOrdering>
-struct merge_sort_by_key_closure
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          thrust::detail::false_type)
 {
-  execution_policy<DerivedPolicy> &exec;
-  Iterator1 first1, last1;
-  Iterator2 first2;
-  Iterator3 first3;
-  Iterator4 first4;
-  StrictWeakOrdering comp;
-  bool inplace;
-
-  merge_sort_by_key_closure(execution_policy<DerivedPolicy> &exec,
-                            Iterator1 first1,
-                            Iterator1 last1,
-                            Iterator2 first2,
-                            Iterator3 first3,
-                            Iterator4 first4,
-                            StrictWeakOrdering comp,
-                            bool inplace)
-    : exec(exec), first1(first1), last1(last1), first2(first2), first3(first3), first4(first4), comp(comp), inplace(inplace)
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
+
+  if(thrust::system::tbb::detail::run_sequentially(exec, thrust::distance(first1, last1)))
+  {
+    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    return;
+  }
+
+  // the ping-pong buffers, filled by the leaves
+  thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(0, exec, thrust::distance(first1, last1));
+  thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(0, exec, thrust::distance(first1, last1));
+
+  typedef merge_sort_pairs<
+    DerivedPolicy,
+    RandomAccessIterator1, RandomAccessIterator2,
+    typename thrust::detail::temporary_array<key_type, DerivedPolicy>::iterator,
+    typename thrust::detail::temporary_array<val_type, DerivedPolicy>::iterator,
+    StrictWeakOrdering
+  > Sorter;
+
+  merge_sort(exec, Sorter(exec, first1, first2, temp1.begin(), temp2.begin(), comp), thrust::distance(first1, last1), sizeof(key_type) + sizeof(val_type));
+}
+
+
+template<typename Encoder, typename RandomAccessIterator, typename IndexType>
+struct radix_histogram_body
+{
+  RandomAccessIterator keys_first;
+  const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp;
+  unsigned int pass;
+  std::size_t *histograms;
+
+  radix_histogram_body(RandomAccessIterator keys_first,
+                       const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp,
+                       unsigned int pass,
+                       std::size_t *histograms)
+    : keys_first(keys_first), decomp(decomp), pass(pass), histograms(histograms)
   {}
 
-  void operator()(void) const
+  void operator()(const ::tbb::blocked_range<IndexType> &r) const
   {
-    merge_sort_by_key(exec, first1, last1, first2, first3, first4, comp, inplace);
+    namespace radix_sort_detail = thrust::system::detail::internal::radix_sort_detail;
+
+    for(IndexType i = r.begin(); i < r.end(); ++i)
+    {
+      radix_sort_detail::histogram_tile<Encoder>(keys_first, decomp[i], pass, histograms + i * radix_sort_detail::radix_size);
+    }
   }
 };
 
 
-template<typename DerivedPolicy,
-         typename Iterator1,
-         typename Iterator2,
-         typename Iterator3,
-         typename Iterator4,
-         typename StrictWeakOrdering>
-void merge_sort_by_key(execution_policy<DerivedPolicy> &exec,
-                       Iterator1 first1,
-                       Iterator1 last1,
-                       Iterator2 first2,
-                       Iterator3 first3,
-                       Iterator4 first4,
-                       StrictWeakOrdering comp,
-                       bool inplace)
+template<typename Encoder,
+         bool HasValues,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename IndexType>
+struct radix_scatter_body
 {
-  typedef typename thrust::iterator_difference<Iterator1>::type difference_type;
+  RandomAccessIterator1 keys_first;
+  RandomAccessIterator2 values_first;
+  RandomAccessIterator3 keys_result;
+  RandomAccessIterator4 values_result;
+  const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp;
+  unsigned int pass;
+  std::size_t *histograms;
+
+  radix_scatter_body(RandomAccessIterator1 keys_first,
+                     RandomAccessIterator2 values_first,
+                     RandomAccessIterator3 keys_result,
+                     RandomAccessIterator4 values_result,
+                     const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp,
+                     unsigned int pass,
+                     std::size_t *histograms)
+    : keys_first(keys_first), values_first(values_first),
+      keys_result(keys_result), values_result(values_result),
+      decomp(decomp), pass(pass), histograms(histograms)
+  {}
 
-  difference_type n = thrust::distance(first1, last1);
+  void operator()(const ::tbb::blocked_range<IndexType> &r) const
+  {
+    namespace radix_sort_detail = thrust::system::detail::internal::radix_sort_detail;
+
+    for(IndexType i = r.begin(); i < r.end(); ++i)
+    {
+      radix_sort_detail::scatter_tile<Encoder,HasValues>(keys_first, values_first,
+                                                         keys_result, values_result,
+                                                         decomp[i], pass,
+                                                         histograms + i * radix_sort_detail::radix_size);
+    }
+  }
+};
 
-  Iterator1 mid1  = first1 + (n / 2);
-  Iterator2 mid2  = first2 + (n / 2);
-  Iterator3 mid3  = first3 + (n / 2);
-  Iterator4 mid4  = first4 + (n / 2);
-  Iterator2 last2 = first2 + n;
-  Iterator3 last3 = first3 + n;
 
-  if (n < threshold)
+template<typename Encoder,
+         bool HasValues,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4,
+         typename IndexType>
+bool radix_pass(execution_policy<DerivedPolicy> &exec,
+                const thrust::system::detail::internal::uniform_decomposition<IndexType> &decomp,
+                RandomAccessIterator1 keys_first,
+                RandomAccessIterator2 values_first,
+                RandomAccessIterator3 keys_result,
+                RandomAccessIterator4 values_result,
+                IndexType n,
+                unsigned int pass,
+                std::size_t *histograms)
+{
+  ::tbb::blocked_range<IndexType> tiles(0, decomp.size(), 1);
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, radix_histogram_body<Encoder,RandomAccessIterator1,IndexType>(keys_first, decomp, pass, histograms));
+
+  if(!thrust::system::detail::internal::radix_sort_detail::scan_histograms(histograms, decomp.size(), n))
   {
-    thrust::stable_sort_by_key(thrust::seq, first1, last1, first2, comp);
+    return false;
+  }
+
+  typedef radix_scatter_body<
+    Encoder, HasValues,
+    RandomAccessIterator1, RandomAccessIterator2, RandomAccessIterator3, RandomAccessIterator4,
+    IndexType
+  > scatter_body;
+
+  thrust::system::tbb::detail::parallel_for(exec, tiles, scatter_body(keys_first, values_first, keys_result, values_result, decomp, pass, histograms));
+
+  return true;
+}
+
+
+// LSD radix sort: every pass counts the digits of each tile in parallel, scans the
+// counts sequentially in bucket-major order, and scatters each tile in parallel
+template<typename Encoder,
+         bool HasValues,
+         typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename RandomAccessIterator3,
+         typename RandomAccessIterator4>
+void radix_sort(execution_policy<DerivedPolicy> &exec,
+                RandomAccessIterator1 keys1,
+                RandomAccessIterator2 keys2,
+                RandomAccessIterator3 vals1,
+                RandomAccessIterator4 vals2,
+                typename thrust::iterator_difference<RandomAccessIterator1>::type n)
+{
+  namespace radix_sort_detail = thrust::system::detail::internal::radix_sort_detail;
+
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type IndexType;
+
+  // one tile per thread of exec's arena
+  const IndexType p = thrust::max<IndexType>(1, thrust::system::tbb::detail::concurrency(exec));
+
+  thrust::system::detail::internal::uniform_decomposition<IndexType> decomp(n, 1, p);
+
+  thrust::detail::temporary_array<std::size_t,DerivedPolicy> histograms(exec, decomp.size() * radix_sort_detail::radix_size);
+  std::size_t *histograms_ptr = thrust::raw_pointer_cast(histograms.data());
+
+  // false if most recent data is stored in (keys1,vals1)
+  bool flip = false;
 
-    if(!inplace)
+  for(unsigned int pass = 0; pass < Encoder::num_passes; ++pass)
+  {
+    const bool shuffled = flip ?
+      radix_pass<Encoder,HasValues>(exec, decomp, keys2, vals2, keys1, vals1, n, pass, histograms_ptr) :
+      radix_pass<Encoder,HasValues>(exec, decomp, keys1, vals1, keys2, vals2, n, pass, histograms_ptr);
+
+    if(shuffled)
     {
-      thrust::copy(thrust::seq, first1, last1, first3);
-      thrust::copy(thrust::seq, first2, last2, first4);
+      flip = !flip;
     }
+  }
 
-    return;
+  // ensure final values are in (keys1,vals1)
+  if(flip)
+  {
+    thrust::copy(exec, keys2, keys2 + n, keys1);
+
+    if(HasValues)
+    {
+      thrust::copy(exec, vals2, vals2 + n, vals1);
+    }
   }
+}
 
-  typedef merge_sort_by_key_closure<DerivedPolicy,Iterator1,Iterator2,Iterator3,Iterator4,StrictWeakOrdering> Closure;
 
-  Closure left (exec, first1, mid1,  first2, first3, first4, comp, !inplace);
-  Closure right(exec, mid1,   last1, mid2,   mid3,   mid4,   comp, !inplace);
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename StrictWeakOrdering>
+void stable_sort(execution_policy<DerivedPolicy> &exec,
+                 RandomAccessIterator first,
+                 RandomAccessIterator last,
+                 StrictWeakOrdering comp,
+                 thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
+  typedef thrust::system::detail::internal::radix_sort_detail::radix_encoder<key_type,StrictWeakOrdering> encoder;
 
-  ::tbb::parallel_invoke(left, right);
+  const typename thrust::iterator_difference<RandomAccessIterator>::type n = thrust::distance(first, last);
 
-  if(inplace)
+  if(static_cast<std::size_t>(n) < thrust::system::detail::internal::radix_sort_detail::parallel_threshold)
   {
-    thrust::merge_by_key(exec, first3, mid3, mid3, last3, first4, mid4, first1, first2, comp);
+    // too few keys for the passes of the radix sort to pay off
+    stable_sort(exec, first, last, comp, thrust::detail::false_type());
+    return;
   }
-  else
+
+  thrust::detail::temporary_array<key_type, DerivedPolicy> keys(exec, n);
+
+  radix_sort<encoder,false>(exec, first, keys.begin(), static_cast<int *>(0), static_cast<int *>(0), n);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
+  typedef thrust::system::detail::internal::radix_sort_detail::radix_encoder<key_type,StrictWeakOrdering> encoder;
+
+  const typename thrust::iterator_difference<RandomAccessIterator1>::type n = thrust::distance(first1, last1);
+
+  if(static_cast<std::size_t>(n) < thrust::system::detail::internal::radix_sort_detail::parallel_threshold)
   {
-    thrust::merge_by_key(exec, first1, mid1, mid1, last1, first2, mid2, first3, first4, comp);
+    stable_sort_by_key(exec, first1, last1, first2, comp, thrust::detail::false_type());
+    return;
   }
+
+  thrust::detail::temporary_array<key_type, DerivedPolicy> keys(exec, n);
+  thrust::detail::temporary_array<val_type, DerivedPolicy> vals(exec, n);
+
+  radix_sort<encoder,true>(exec, first1, keys.begin(), first2, vals.begin(), n);
+}
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename UseRadixSort>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          UseRadixSort use_radix_sort,
+                          thrust::detail::false_type)
+{
+  stable_sort_by_key(exec, first1, last1, first2, comp, use_radix_sort);
+}
+
+
+// sorts the keys together with the indices of their values, then moves each value once
+template<typename DerivedPolicy,
+         typename RandomAccessIterator1,
+         typename RandomAccessIterator2,
+         typename StrictWeakOrdering,
+         typename UseRadixSort>
+  void stable_sort_by_key(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator1 first1,
+                          RandomAccessIterator1 last1,
+                          RandomAccessIterator2 first2,
+                          StrictWeakOrdering comp,
+                          UseRadixSort use_radix_sort,
+                          thrust::detail::true_type)
+{
+  typedef typename thrust::iterator_difference<RandomAccessIterator1>::type index_type;
+  typedef typename thrust::iterator_value<RandomAccessIterator2>::type      val_type;
+
+  const index_type n = thrust::distance(first1, last1);
+
+  thrust::detail::temporary_array<index_type,DerivedPolicy> indices(exec, n);
+  thrust::sequence(exec, indices.begin(), indices.end());
+
+  stable_sort_by_key(exec, first1, last1, indices.begin(), comp, use_radix_sort);
+
+  thrust::detail::temporary_array<val_type,DerivedPolicy> vals(exec, first2, n);
+  thrust::gather(exec, indices.begin(), indices.end(), vals.begin(), first2);
 }
 
 
@@ -239,9 +620,17 @@ void stable_sort(execution_policy<DerivedPolicy> &exec,
 {
   typedef typename thrust::iterator_value<RandomAccessIterator>::type key_type;
 
-  thrust::detail::temporary_array<key_type, DerivedPolicy> temp(exec, first, last);
+  // primitive keys compared with less or greater take the radix sort
+  thrust::system::detail::internal::radix_sort_detail::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
 
-  sort_detail::merge_sort(exec, first, last, temp.begin(), comp, true);
+  if(thrust::system::tbb::detail::run_sequentially(exec, thrust::distance(first, last)))
+  {
+    // the merge sort hands small inputs to the sequential sort before allocating its buffer
+    sort_detail::stable_sort(exec, first, last, comp, thrust::detail::false_type());
+    return;
+  }
+
+  sort_detail::stable_sort(exec, first, last, comp, use_radix_sort);
 }
 
 
@@ -258,12 +647,19 @@ template<typename DerivedPolicy,
   typedef typename thrust::iterator_value<RandomAccessIterator1>::type key_type;
   typedef typename thrust::iterator_value<RandomAccessIterator2>::type val_type;
 
-  RandomAccessIterator2 last2 = first2 + thrust::distance(first1, last1);
+  // primitive keys compared with less or greater take the radix sort
+  thrust::system::detail::internal::radix_sort_detail::use_radix_sort<key_type,StrictWeakOrdering> use_radix_sort;
+
+  // large values follow their keys by index
+  thrust::system::detail::internal::use_index_sort<val_type> use_index_sort;
 
-  thrust::detail::temporary_array<key_type, DerivedPolicy> temp1(exec, first1, last1);
-  thrust::detail::temporary_array<val_type, DerivedPolicy> temp2(exec, first2, last2);
+  if(thrust::system::tbb::detail::run_sequentially(exec, thrust::distance(first1, last1)))
+  {
+    sort_detail::stable_sort_by_key(exec, first1, last1, first2, comp, thrust::detail::false_type());
+    return;
+  }
 
-  sort_by_key_detail::merge_sort_by_key(exec, first1, last1, first2, temp1.begin(), temp2.begin(), comp, true);
+  sort_detail::stable_sort_by_key(exec, first1, last1, first2, comp, use_radix_sort, use_index_sort);
 }
 
 
@@ -26,5 +26,46 @@
 #  pragma system_header
 #endif // no system header
 
-// this system has no special temporary buffer functions
+// temporary storage is cached by a pool of each thread, unless
+// THRUST_TBB_DISABLE_TEMPORARY_POOL is defined
+#if _CCCL_STD_VER >= 2011 && !defined(THRUST_TBB_DISABLE_TEMPORARY_POOL)
 
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/detail/internal/temporary_pool.h>
+#include <thrust/detail/execution_policy.h>
+#include <thrust/pair.h>
+
+#include <cstddef>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+
+template<typename T, typename DerivedPolicy>
+_CCCL_HOST
+  thrust::pair<T*, std::ptrdiff_t>
+    get_temporary_buffer(execution_policy<DerivedPolicy> &, std::ptrdiff_t n)
+{
+  return thrust::make_pair(thrust::system::detail::internal::allocate_temporary<T>(n), n);
+} // end get_temporary_buffer()
+
+
+template<typename DerivedPolicy, typename Pointer>
+_CCCL_HOST
+  void return_temporary_buffer(execution_policy<DerivedPolicy> &exec, Pointer p, std::ptrdiff_t n)
+{
+  thrust::system::detail::internal::return_temporary(thrust::detail::derived_cast(exec), p, n);
+} // end return_temporary_buffer()
+
+
+} // end detail
+} // end tbb
+} // end system
+THRUST_NAMESPACE_END
+
+#endif // no temporary pool
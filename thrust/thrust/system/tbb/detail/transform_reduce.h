@@ -14,6 +14,11 @@
  *  limitations under the License.
  */
 
+
+/*! \file transform_reduce.h
+ *  \brief TBB implementation of transform_reduce.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
@@ -25,7 +30,33 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/system/tbb/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// each tile reduces the transformed elements in a plain loop over the input rather
+// than through a transform_iterator, so arithmetic on contiguous inputs vectorizes
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename UnaryFunction,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType transform_reduce(execution_policy<DerivedPolicy> &exec,
+                              InputIterator first,
+                              InputIterator last,
+                              UnaryFunction unary_op,
+                              OutputType init,
+                              BinaryFunction binary_op);
 
-// this system inherits transform_reduce
-#include <thrust/system/cpp/detail/transform_reduce.h>
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
 
+#include <thrust/system/tbb/detail/transform_reduce.inl>
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/transform_reduce.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/system/detail/internal/transform_reduce.h>
+#include <thrust/detail/function.h>
+#include <thrust/detail/seq.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/distance.h>
+#include <thrust/transform_reduce.h>
+#include <tbb/blocked_range.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace transform_reduce_detail
+{
+
+
+template<typename IndexFunction,
+         typename OutputType,
+         typename BinaryFunction>
+struct body
+{
+  IndexFunction f;
+  OutputType sum;
+  bool first_call;  // TBB can invoke operator() multiple times on the same body
+  thrust::detail::wrapped_function<BinaryFunction,OutputType> binary_op;
+
+  // note: we only initalize sum with init to avoid calling OutputType's default constructor
+  body(IndexFunction f, OutputType init, BinaryFunction binary_op)
+    : f(f), sum(init), first_call(true), binary_op(binary_op)
+  {}
+
+  // note: we only initalize sum with b.sum to avoid calling OutputType's default constructor
+  body(body& b, ::tbb::split)
+    : f(b.f), sum(b.sum), first_call(true), binary_op(b.binary_op)
+  {}
+
+  template <typename Size>
+  void operator()(const ::tbb::blocked_range<Size> &r)
+  {
+    if (r.empty()) return; // nothing to do
+
+    OutputType temp = thrust::system::detail::internal::reduce_tile<OutputType>(r.begin(), r.end(), f, binary_op);
+
+    if (first_call)
+    {
+      // first time body has been invoked
+      first_call = false;
+      sum = temp;
+    }
+    else
+    {
+      // body has been previously invoked, accumulate temp into sum
+      sum = binary_op(sum, temp);
+    }
+  } // end operator()()
+
+  void join(body& b)
+  {
+    sum = binary_op(sum, b.sum);
+  }
+}; // end body
+
+
+// reduces init with f(0), ..., f(n - 1), where f(i) is a function of the i-th element(s) of the input
+template<typename DerivedPolicy,
+         typename Size,
+         typename IndexFunction,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType reduce_indices(execution_policy<DerivedPolicy> &exec,
+                            Size n,
+                            IndexFunction f,
+                            OutputType init,
+                            BinaryFunction binary_op)
+{
+  typedef body<IndexFunction,OutputType,BinaryFunction> Body;
+  Body reduce_body(f, init, binary_op);
+  ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+  thrust::system::tbb::detail::parallel_reduce(exec, range, reduce_body);
+  return reduce_body.binary_op(init, reduce_body.sum);
+} // end reduce_indices()
+
+
+} // end transform_reduce_detail
+
+
+template<typename DerivedPolicy,
+         typename InputIterator,
+         typename UnaryFunction,
+         typename OutputType,
+         typename BinaryFunction>
+  OutputType transform_reduce(execution_policy<DerivedPolicy> &exec,
+                              InputIterator first,
+                              InputIterator last,
+                              UnaryFunction unary_op,
+                              OutputType init,
+                              BinaryFunction binary_op)
+{
+  typedef typename thrust::iterator_difference<InputIterator>::type difference_type;
+
+  const difference_type n = thrust::distance(first, last);
+
+  if(n == 0)
+  {
+    return init;
+  }
+  else if(thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::transform_reduce(thrust::seq, first, last, unary_op, init, binary_op);
+  }
+
+  // wrap unary_op
+  thrust::detail::wrapped_function<UnaryFunction,OutputType> wrapped_unary_op(unary_op);
+
+  typedef thrust::system::detail::internal::transform_at<
+    InputIterator,
+    thrust::detail::wrapped_function<UnaryFunction,OutputType>,
+    OutputType
+  > IndexFunction;
+
+  return transform_reduce_detail::reduce_indices(exec, n, IndexFunction(first, wrapped_unary_op), init, binary_op);
+} // end transform_reduce()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
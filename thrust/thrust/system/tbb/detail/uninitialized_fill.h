@@ -14,6 +14,10 @@
  *  limitations under the License.
  */
 
+/*! \file uninitialized_fill.h
+ *  \brief TBB implementation of uninitialized_fill.
+ */
+
 #pragma once
 
 #include <thrust/detail/config.h>
@@ -25,7 +29,41 @@
 #elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
 #  pragma system_header
 #endif // no system header
+#include <thrust/system/tbb/detail/execution_policy.h>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// the storage of tbb vectors is constructed here, so each page is first touched by
+// the thread which the static partitioner assigns it, unless par.partitioner()
+// requests another one. on NUMA systems, the pages are then local to the threads
+// of loops which are partitioned the same way. elements whose copy constructor
+// may throw are constructed sequentially
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  RandomAccessIterator uninitialized_fill_n(execution_policy<DerivedPolicy> &exec,
+                                            RandomAccessIterator first,
+                                            Size n,
+                                            const T &x);
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename T>
+  void uninitialized_fill(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator first,
+                          RandomAccessIterator last,
+                          const T &x);
 
-// this system inherits uninitialized_fill
-#include <thrust/system/cpp/detail/uninitialized_fill.h>
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
 
+#include <thrust/system/tbb/detail/uninitialized_fill.inl>
@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/system/tbb/detail/uninitialized_fill.h>
+#include <thrust/system/tbb/detail/parallelism.h>
+#include <thrust/detail/seq.h>
+#include <thrust/distance.h>
+#include <thrust/iterator/iterator_traits.h>
+#include <thrust/uninitialized_fill.h>
+
+#include <tbb/blocked_range.h>
+
+#include <type_traits>
+
+THRUST_NAMESPACE_BEGIN
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+namespace uninitialized_fill_detail
+{
+
+
+template<typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  struct body
+{
+  RandomAccessIterator m_first;
+  const T &m_x;
+
+  body(RandomAccessIterator first, const T &x)
+    : m_first(first), m_x(x)
+  {}
+
+  void operator()(const ::tbb::blocked_range<Size> &r) const
+  {
+    thrust::uninitialized_fill_n(thrust::seq, m_first + r.begin(), r.size(), m_x);
+  } // end operator()()
+}; // end body
+
+
+} // end uninitialized_fill_detail
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename Size,
+         typename T>
+  RandomAccessIterator uninitialized_fill_n(execution_policy<DerivedPolicy> &exec,
+                                            RandomAccessIterator first,
+                                            Size n,
+                                            const T &x)
+{
+  if(n <= 0) return first;
+
+  typedef typename thrust::iterator_value<RandomAccessIterator>::type value_type;
+
+  // a copy constructor which throws in a tile would leave the elements of the other tiles constructed, so
+  // only elements which are copied without throwing are first touched in parallel
+  if(!std::is_nothrow_constructible<value_type, const T&>::value ||
+     thrust::system::tbb::detail::run_sequentially(exec, n))
+  {
+    return thrust::uninitialized_fill_n(thrust::seq, first, n, x);
+  }
+
+  ::tbb::blocked_range<Size> range(0, n, thrust::system::tbb::detail::grain_size(exec, Size(1)));
+
+  uninitialized_fill_detail::body<RandomAccessIterator,Size,T> body(first, x);
+
+  thrust::system::tbb::detail::parallel_for(exec, range, body, thrust::system::tbb::partitioner_static);
+
+  return first + n;
+} // end uninitialized_fill_n()
+
+
+template<typename DerivedPolicy,
+         typename RandomAccessIterator,
+         typename T>
+  void uninitialized_fill(execution_policy<DerivedPolicy> &exec,
+                          RandomAccessIterator first,
+                          RandomAccessIterator last,
+                          const T &x)
+{
+  thrust::system::tbb::detail::uninitialized_fill_n(exec, first, thrust::distance(first, last), x);
+} // end uninitialized_fill()
+
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+THRUST_NAMESPACE_END
@@ -26,6 +26,7 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/tbb/detail/unique.h>
+#include <thrust/system/tbb/detail/compact.h>
 #include <thrust/system/detail/generic/unique.h>
 #include <thrust/pair.h>
 
@@ -46,8 +47,9 @@ template<typename DerivedPolicy,
                          ForwardIterator last,
                          BinaryPredicate binary_pred)
 {
-  // tbb prefers generic::unique to cpp::unique
-  return thrust::system::detail::generic::unique(exec,first,last,binary_pred);
+  compact_detail::unique_selector<ForwardIterator,BinaryPredicate> select(first, binary_pred);
+
+  return thrust::system::tbb::detail::compact_in_place(exec, first, last, select);
 } // end unique()
 
 
@@ -61,8 +63,9 @@ template<typename DerivedPolicy,
                              OutputIterator output,
                              BinaryPredicate binary_pred)
 {
-  // tbb prefers generic::unique_copy to cpp::unique_copy
-  return thrust::system::detail::generic::unique_copy(exec,first,last,output,binary_pred);
+  compact_detail::unique_selector<InputIterator,BinaryPredicate> select(first, binary_pred);
+
+  return thrust::system::tbb::detail::compact(exec, first, last, output, select);
 } // end unique_copy()
 
 
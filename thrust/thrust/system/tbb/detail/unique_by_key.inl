@@ -26,7 +26,9 @@
 #  pragma system_header
 #endif // no system header
 #include <thrust/system/tbb/detail/unique_by_key.h>
-#include <thrust/system/detail/generic/unique_by_key.h>
+#include <thrust/system/tbb/detail/compact.h>
+#include <thrust/iterator/zip_iterator.h>
+#include <thrust/distance.h>
 #include <thrust/pair.h>
 
 THRUST_NAMESPACE_BEGIN
@@ -49,8 +51,17 @@ template<typename DerivedPolicy,
                   ForwardIterator2 values_first,
                   BinaryPredicate binary_pred)
 {
-  // tbb prefers generic::unique_by_key to cpp::unique_by_key
-  return thrust::system::detail::generic::unique_by_key(exec,keys_first,keys_last,values_first,binary_pred);
+  typedef thrust::zip_iterator<thrust::tuple<ForwardIterator1,ForwardIterator2> > ZipIterator;
+
+  // the keys select which pairs to keep, and each key moves with its value
+  compact_detail::unique_selector<ForwardIterator1,BinaryPredicate> select(keys_first, binary_pred);
+
+  ZipIterator first = thrust::make_zip_iterator(thrust::make_tuple(keys_first, values_first));
+  ZipIterator last  = first + thrust::distance(keys_first, keys_last);
+
+  ZipIterator result = thrust::system::tbb::detail::compact_in_place(exec, first, last, select);
+
+  return thrust::make_pair(thrust::get<0>(result.get_iterator_tuple()), thrust::get<1>(result.get_iterator_tuple()));
 } // end unique_by_key()
 
 
@@ -69,8 +80,16 @@ template<typename DerivedPolicy,
                        OutputIterator2 values_output,
                        BinaryPredicate binary_pred)
 {
-  // tbb prefers generic::unique_by_key_copy to cpp::unique_by_key_copy
-  return thrust::system::detail::generic::unique_by_key_copy(exec,keys_first,keys_last,values_first,keys_output,values_output,binary_pred);
+  compact_detail::unique_selector<InputIterator1,BinaryPredicate> select(keys_first, binary_pred);
+
+  thrust::zip_iterator<thrust::tuple<OutputIterator1,OutputIterator2> > result =
+    thrust::system::tbb::detail::compact(exec,
+                                         thrust::make_zip_iterator(thrust::make_tuple(keys_first, values_first)),
+                                         thrust::make_zip_iterator(thrust::make_tuple(keys_last, values_first)),
+                                         thrust::make_zip_iterator(thrust::make_tuple(keys_output, values_output)),
+                                         select);
+
+  return thrust::make_pair(thrust::get<0>(result.get_iterator_tuple()), thrust::get<1>(result.get_iterator_tuple()));
 } // end unique_by_key_copy()
 
 
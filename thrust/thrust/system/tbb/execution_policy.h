@@ -69,9 +69,11 @@
 #include <thrust/system/tbb/detail/scatter.h>
 #include <thrust/system/tbb/detail/sequence.h>
 #include <thrust/system/tbb/detail/set_operations.h>
+#include <thrust/system/tbb/detail/shuffle.h>
 #include <thrust/system/tbb/detail/sort.h>
 #include <thrust/system/tbb/detail/swap_ranges.h>
 #include <thrust/system/tbb/detail/tabulate.h>
+#include <thrust/system/tbb/detail/temporary_buffer.h>
 #include <thrust/system/tbb/detail/transform.h>
 #include <thrust/system/tbb/detail/transform_reduce.h>
 #include <thrust/system/tbb/detail/transform_scan.h>
@@ -123,6 +125,36 @@ struct tag : thrust::system::tbb::execution_policy<tag> { unspecified };
  *
  *  The type of \p thrust::tbb::par is implementation-defined.
  *
+ *  Algorithms given fewer elements than \p THRUST_TBB_SEQUENTIAL_CUTOFF (4096 unless defined
+ *  before including Thrust) run sequentially on the calling thread instead of spawning tasks.
+ *  The cutoff of a single call may be set with \p thrust::tbb::par.sequential_cutoff(n), and may be
+ *  combined with an allocator, as in \p thrust::tbb::par(alloc).sequential_cutoff(n);
+ *  a cutoff of zero always executes in parallel.
+ *
+ *  The temporary storage of algorithms is cached by a pool of the calling thread, up to 256 MiB per
+ *  thread, so repeated invocations do not return to the system allocator. The storage cached by every
+ *  thread is released with \p thrust::tbb::release_temporary_storage(). Defining
+ *  \p THRUST_TBB_DISABLE_TEMPORARY_POOL before including Thrust allocates it with \p thrust::tbb::malloc
+ *  instead. Temporary storage of \p thrust::tbb::par(alloc) always comes from \p alloc.
+ *
+ *  An algorithm may be confined to a \p tbb::task_arena with \p thrust::tbb::par.arena(a); the arena
+ *  is referenced rather than copied, and its concurrency also sets the number of tiles algorithms
+ *  divide their input into. The partitioner of its parallel loops may be requested with
+ *  \p thrust::tbb::par.partitioner(kind), where \p kind is one of \p thrust::tbb::partitioner_auto,
+ *  \p thrust::tbb::partitioner_simple, \p thrust::tbb::partitioner_static or
+ *  \p thrust::tbb::partitioner_affinity, and the grain size of loops over elements with
+ *  \p thrust::tbb::par.grain_size(n). These may be combined, as in
+ *  \p thrust::tbb::par.arena(a).partitioner(thrust::tbb::partitioner_static).grain_size(1024).
+ *  Otherwise, each algorithm chooses its own partitioner and grain size in the calling thread's arena.
+ *
+ *  Algorithms invoked repeatedly over the same data may attach a \p thrust::tbb::affinity_handle
+ *  with \p thrust::tbb::par.affinity(h). Every loop invoked with \p h shares one affinity
+ *  partitioner, so a loop over a range of the same size replays the chunk-to-thread mapping of
+ *  the previous one and finds its chunk in the cache of the thread which last touched it.
+ *  The handle is referenced rather than copied. Only one loop at a time uses its partitioner, so the
+ *  loops an algorithm runs within its own, such as the merges of \p thrust::stable_sort, and loops
+ *  invoked with \p h by other threads meanwhile, run with the auto partitioner.
+ *
  *  The following code snippet demonstrates how to use \p thrust::tbb::par to explicitly dispatch an
  *  invocation of \p thrust::for_each to the TBB backend system:
  *
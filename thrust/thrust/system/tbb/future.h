@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2008-2013 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file thrust/system/tbb/future.h
+ *  \brief Events and futures of Thrust's TBB system.
+ */
+
+#pragma once
+
+#include <thrust/detail/config.h>
+
+#if defined(_CCCL_IMPLICIT_SYSTEM_HEADER_GCC)
+#  pragma GCC system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_CLANG)
+#  pragma clang system_header
+#elif defined(_CCCL_IMPLICIT_SYSTEM_HEADER_MSVC)
+#  pragma system_header
+#endif // no system header
+#include <thrust/detail/cpp14_required.h>
+
+#if _CCCL_STD_VER >= 2014
+
+#include <thrust/system/tbb/pointer.h>
+#include <thrust/system/tbb/detail/execution_policy.h>
+#include <thrust/system/detail/internal/eager_future.h>
+
+THRUST_NAMESPACE_BEGIN
+
+namespace system { namespace tbb
+{
+
+// the asynchronous algorithms of the TBB system run as a task of a tbb::task_group
+// in the arena of their policy, after each event or future they were given with
+// par.after() has completed. destroying a valid event or future blocks until its
+// algorithm has completed
+using unique_eager_event = thrust::system::detail::internal::eager_event<tag>;
+
+template <typename T>
+using unique_eager_future = thrust::system::detail::internal::eager_future<tag, T>;
+
+template <typename... Events>
+_CCCL_HOST
+unique_eager_event when_all(Events&&... evs);
+
+}} // namespace system::tbb
+
+namespace tbb
+{
+
+using thrust::system::tbb::unique_eager_event;
+using event = unique_eager_event;
+
+using thrust::system::tbb::unique_eager_future;
+template <typename T> using future = unique_eager_future<T>;
+
+using thrust::system::tbb::when_all;
+
+} // namespace tbb
+
+template <typename DerivedPolicy>
+_CCCL_HOST
+thrust::tbb::unique_eager_event
+unique_eager_event_type(
+  thrust::tbb::execution_policy<DerivedPolicy> const&
+) noexcept;
+
+template <typename T, typename DerivedPolicy>
+_CCCL_HOST
+thrust::tbb::unique_eager_future<T>
+unique_eager_future_type(
+  thrust::tbb::execution_policy<DerivedPolicy> const&
+) noexcept;
+
+THRUST_NAMESPACE_END
+
+#include <thrust/system/tbb/detail/future.inl>
+
+#endif // C++14
+
@@ -74,6 +74,14 @@ inline pointer<T> malloc(std::size_t n);
  */
 inline void free(pointer<void> ptr);
 
+/*! Returns the temporary storage cached by every thread to the system.
+ *  Unless \p THRUST_TBB_DISABLE_TEMPORARY_POOL is defined, the temporary storage of
+ *  algorithms dispatched to the <tt>tbb</tt> system is cached by a pool of the thread
+ *  which invokes them, up to 256 MiB, and is otherwise only released when that thread exits.
+ *  Storage in use by an algorithm running on another thread is cached again once it is returned.
+ */
+inline void release_temporary_storage();
+
 /*! \p tbb::allocator is the default allocator used by the \p tbb system's
  *  containers such as <tt>tbb::vector</tt> if no user-specified allocator is
  *  provided. \p tbb::allocator allocates (deallocates) storage with \p
@@ -101,6 +109,7 @@ namespace tbb
 {
 using thrust::system::tbb::malloc;
 using thrust::system::tbb::free;
+using thrust::system::tbb::release_temporary_storage;
 using thrust::system::tbb::allocator;
 using thrust::system::tbb::universal_allocator;
 } // namsespace tbb